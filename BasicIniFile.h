@@ -0,0 +1,1134 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_BASICINIFILE_H
+#define INIMANAGER_BASICINIFILE_H
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "IniPolicies.h"
+#include "IniStats.h"
+#include "IniMemoryUsage.h"
+#include "IniInterpolator.h"
+#include "IniLazyComments.h"
+#include "IniSection.h"
+#include "IniTracer.h"
+
+using namespace std;
+
+class IniTransaction;
+
+struct IniChange
+{
+    enum class Type { Added, Modified, Removed };
+
+    IniChange() = default;
+    IniChange(Type type, string_view section, string_view key, string_view oldValue, string_view newValue)
+        : type(type), section(section), key(key), oldValue(oldValue), newValue(newValue)
+    {
+    }
+
+    Type type = Type::Added;
+    string section;
+    string key;
+    string oldValue;
+    string newValue;
+};
+
+enum class IniCommentMode
+{
+    Keep,   // commenti conservati e riscritti da save/print
+    Skip,   // righe di commento saltate senza allocare: per chi legge soltanto
+    Lazy    // solo gli intervalli di byte; le stringhe vengono create al primo accesso ai commenti
+};
+
+// File INI parametrizzato sulle policy di IniPolicies.h: ogni combinazione compila solo il lavoro che le
+// serve (niente folding con IniCaseSensitive, niente commenti con IniDropComments, lock vuoti con
+// IniNoLocking). IniFile e' la combinazione predefinita; statistiche, tracing, interpolazione, commenti
+// pigri, transazioni, diff e sezioni copy-on-write valgono per tutte. Stringhe e contenitori usano
+// Allocator, quindi con pmr tutto il contenuto sta nella risorsa passata al costruttore.
+template <typename CasePolicy = IniCaseInsensitive, typename CommentPolicy = IniKeepComments,
+          typename StoragePolicy = IniOrderedStorage, typename LockingPolicy = IniNoLocking,
+          typename Allocator = pmr::polymorphic_allocator<char>>
+class BasicIniFile
+{
+    public:
+        using String = basic_string<char, char_traits<char>, Allocator>;
+        using Keys = typename StoragePolicy::template Map<String, String, Allocator>;
+        using CommentMode = IniCommentMode;
+
+        BasicIniFile() = default;
+        explicit BasicIniFile(const Allocator& allocator);
+        explicit BasicIniFile(string name, CommentMode comments = CommentMode::Keep, const Allocator& allocator = Allocator());
+        BasicIniFile(const BasicIniFile& other, const Allocator& allocator);     // copia il contenuto in un altro allocatore
+        BasicIniFile(const BasicIniFile&) = default;    // la copia usa la risorsa predefinita, come i contenitori pmr
+        BasicIniFile(BasicIniFile&&) = default;
+        BasicIniFile& operator=(const BasicIniFile&) = default;     // l'assegnamento mantiene la risorsa della destinazione
+        BasicIniFile& operator=(BasicIniFile&&) = default;
+        Allocator get_allocator() const;
+        pmr::memory_resource* resource() const;     // solo con polymorphic_allocator
+        void load(const string& name, CommentMode comments = CommentMode::Keep);    // IniDropComments salta sempre i commenti
+        void save(const string& name) const;
+        void save() const;
+        string get(const string& section, const string& key) const;
+        string_view getView(const string& section, const string& key) const;     // valida finche' la chiave non cambia
+        string getResolved(const string& section, const string& key) const;     // con i riferimenti ${...} risolti
+        void set(const string& section, const string& key, const string& value);
+        void addSection(const string& section);
+        bool hasSection(const string& section) const;
+        bool hasKey(const string& section, const string& key) const;
+        vector<string> hasKey(const string& key) const;
+        vector<String, typename allocator_traits<Allocator>::template rebind_alloc<String>>
+        hasKey(const string& key, const Allocator& allocator) const;
+        bool deleteSection(const string& section);
+        bool deleteKey(const string& section, const string& key);
+        bool setSectionComment(const string& section, const string& comment);   // false anche con IniDropComments
+        bool setKeyComment(const string& section, const string& key, const string& comment);
+        string getSectionComment(const string& section) const;
+        string getKeyComment(const string& section, const string& key) const;
+        string print(bool print_comments) const;
+        String print(bool print_comments, const Allocator& allocator) const;
+        static vector<IniChange> diff(const BasicIniFile& from, const BasicIniFile& to);
+        size_t sharedSections(const BasicIniFile& other) const;     // sezioni copy-on-write non ancora separate
+        void commit(const IniTransaction& transaction, vector<IniChange>* changes = nullptr);  // in IniTransaction.h
+        IniFileStats stats() const;
+        IniMemoryUsage memoryUsage() const;     // non materializza i commenti di CommentMode::Lazy
+        void resetStats();
+
+    private:
+        friend class ConcurrentIniFile;
+        friend class SharedIniSegment;
+        friend class IniTransaction;
+        friend class VersionedIniFile;
+        friend class LayeredIniFile;
+        friend class IniDirectoryLoader;
+        friend class IniSnapshot;
+
+        static constexpr bool keepsComments = CommentPolicy::keepsComments;
+
+        using Mutex = typename LockingPolicy::Mutex;
+        using Section = BasicIniSection<Keys>;
+        using Sections = typename StoragePolicy::template Map<String, Section, Allocator>;     // sezioni copy-on-write
+        using LookupKey = conditional_t<StoragePolicy::heterogeneousLookup, string, String>;
+
+        struct NoComments       // IniDropComments: nessun commento in memoria
+        {
+            NoComments() = default;
+            explicit NoComments(const Allocator&) {}
+        };
+
+        // una riga significativa del file: intestazione di sezione oppure coppia chiave=valore
+        struct ParsedLine
+        {
+            bool section;
+            string_view name;
+            string_view value;
+            String comment;             // commenti che precedono la riga
+            String folded;              // name normalizzato, riempito nella fase di folding con l'allocatore del file
+            string_view commentBlock;   // CommentMode::Lazy: righe di commento che precedono la riga, nel buffer
+        };
+
+        string fileName;
+        Sections data;              // sezioni, chiavi, valori e commenti usano tutti l'allocatore del file
+        mutable conditional_t<keepsComments, Keys, NoComments> sectionComments;     // mutable: riempite da materializeComments()
+        mutable conditional_t<keepsComments, Sections, NoComments> keyComments;
+        mutable conditional_t<keepsComments, IniLazyComments, NoComments> lazyComments;
+        mutable IniInterpolator interpolator;
+        INI_STATS(mutable IniStatsCounters counters;)
+        mutable Mutex mutex;
+
+        static string toLower(const string& str);
+        static const string& foldForLookup(const string& str);
+        static const LookupKey& lookupKey(const string& name);
+        static pair<shared_lock<Mutex>, shared_lock<Mutex>> lockBoth(const BasicIniFile& a, const BasicIniFile& b);
+        String folded(string_view name) const;      // nome normalizzato, allocato con l'allocatore del file
+        const String* find(const string& section, const string& key) const;
+        void materializeComments() const;   // da chiamare prima di leggere sectionComments o keyComments
+        template <typename Map, typename Visit>
+        static void forEachInOrder(const Map& map, Visit&& visit);     // ordine dei nomi se StoragePolicy::sorted
+        template <typename Output>
+        void printTo(Output& output, bool print_comments) const;
+};
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::BasicIniFile(const Allocator& allocator)
+    : data(allocator), sectionComments(allocator), keyComments(allocator)
+{
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::BasicIniFile(string name, CommentMode comments,
+                                                                                             const Allocator& allocator)
+    : fileName(std::move(name)), data(allocator), sectionComments(allocator), keyComments(allocator)
+{
+    try
+    {
+        load(fileName, comments);
+    }
+    catch (const exception& e)
+    {
+        cerr << "Error loading INI file: " << e.what() << endl;
+    }
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::BasicIniFile(const BasicIniFile& other,
+                                                                                             const Allocator& allocator)
+    : data(allocator), sectionComments(allocator), keyComments(allocator)
+{
+    shared_lock<Mutex> lock(other.mutex);
+    fileName = other.fileName;
+    data = other.data;
+    if constexpr (keepsComments)
+    {
+        other.materializeComments();
+        sectionComments = other.sectionComments;
+        keyComments = other.keyComments;
+    }
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+Allocator BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::get_allocator() const
+{
+    return Allocator(data.get_allocator());
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+pmr::memory_resource* BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::resource() const
+{
+    return get_allocator().resource();
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::load(const string& name, CommentMode comments)
+{
+    if constexpr (!keepsComments)
+        comments = CommentMode::Skip;
+    INI_STATS(IniStatsTimer timer(counters.loadNanos, counters.lastLoadNanos));
+    INI_STATS(IniStatsCounters::add(counters.loads));
+    IniTracer* tracer = IniTracer::installed();
+    IniTraceSpan loadSpan("IniFile::load", tracer);
+
+    // fase 1: lettura dell'intero file in un unico buffer, senza tenere il lock
+    string buffer;
+    {
+        IniTraceSpan span("load.read", tracer);
+        ifstream file(name, ios::binary);    // apre il file in lettura
+
+        if (!file.is_open())
+            throw runtime_error("Unable to open file: " + name);
+
+        file.seekg(0, ios::end);
+        streamoff size = file.tellg();
+        file.seekg(0, ios::beg);
+        if (size > 0)
+        {
+            buffer.resize(static_cast<size_t>(size));
+            file.read(&buffer[0], size);
+            buffer.resize(static_cast<size_t>(file.gcount()));
+        }
+        else    // file speciali (pipe, /proc) di cui non si conosce la dimensione
+        {
+            file.clear();
+            buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        }
+
+        if (file.bad()) // controlla se ci sono stati errori durante la lettura
+            throw runtime_error("Error reading the file: " + name);
+        INI_STATS(IniStatsCounters::add(counters.bytesParsed, buffer.size()));
+    }
+
+    unique_lock<Mutex> lock(mutex);
+    fileName = name;
+    interpolator.clear();
+    materializeComments();      // i commenti pendenti puntano al buffer del caricamento precedente
+
+    // fase 2: scomposizione in righe, senza copiare nomi e valori
+    vector<ParsedLine> lines;
+    {
+        IniTraceSpan span("load.parse", tracer);
+        lines.reserve(static_cast<size_t>(count(buffer.begin(), buffer.end(), '\n')) + 1);    // una sola allocazione di appoggio
+        String comment(get_allocator());
+        string_view commentBlock;
+        string_view text(buffer);
+
+        while (!text.empty())
+        {
+            size_t end = text.find('\n');
+            string_view line = text.substr(0, end);
+            text.remove_prefix(end == string_view::npos ? text.size() : end + 1);
+
+            if (!line.empty() && line.back() == '\r')   // file con terminatori CRLF
+                line.remove_suffix(1);
+
+            if (line.empty())
+                continue;
+
+            if (line[0] == ';')
+            {
+                if (comments == CommentMode::Keep)
+                    comment.append(line).append("\n");
+                else if (comments == CommentMode::Lazy)
+                {
+                    // le righe sono contigue nel buffer: basta estendere l'intervallo
+                    const char* begin = commentBlock.empty() ? line.data() : commentBlock.data();
+                    commentBlock = string_view(begin, static_cast<size_t>(line.data() + line.size() - begin));
+                }
+                continue;
+            }
+
+            if (line[0] == '[')
+            {
+                lines.push_back({true, line.substr(1, line.size() - 2), {}, std::move(comment), String(get_allocator()),
+                                 commentBlock});
+                comment.clear();
+                commentBlock = {};
+                continue;
+            }
+
+            size_t pos = line.find('=');
+            if (pos == string_view::npos)
+                continue;
+
+            lines.push_back({false, line.substr(0, pos), line.substr(pos + 1), std::move(comment), String(get_allocator()),
+                             commentBlock});
+            comment.clear();
+            commentBlock = {};
+        }
+    }
+
+    // fase 3: nomi di sezioni e chiavi normalizzati secondo CasePolicy
+    {
+        IniTraceSpan span("load.fold", tracer);
+        for (auto& line : lines)
+        {
+            line.folded.assign(line.name);
+            CasePolicy::fold(line.folded);
+        }
+    }
+
+    // fase 4: inserimento nelle mappe
+    IniTraceSpan span("load.insert", tracer);
+    String section(get_allocator());
+    string_view sectionName;
+    Keys* keys = nullptr;
+    for (auto& line : lines)
+    {
+        if (line.section)
+        {
+            // IniAdaptiveStorage accoda le chiavi delle sezioni grandi: si ordinano alla fine della sezione,
+            // invece che a ogni inserimento
+            if (keys != nullptr)
+                StoragePolicy::restoreOrder(*keys);
+            section = std::move(line.folded);
+            sectionName = line.name;
+            keys = nullptr;     // la sezione viene creata solo alla prima chiave
+            if constexpr (keepsComments)
+            {
+                if (!line.commentBlock.empty())
+                    lazyComments.addSection(buffer, sectionName, line.commentBlock);
+                if (!line.comment.empty())
+                {
+                    INI_STATS(IniStatsCounters::add(counters.allocations));
+                    sectionComments.insert_or_assign(section, std::move(line.comment));
+                }
+            }
+            continue;
+        }
+
+        if (keys == nullptr)
+        {
+            auto inserted = data.try_emplace(section);
+            keys = &inserted.first->second.edit();     // una sola verifica di condivisione per sezione
+            INI_STATS(IniStatsCounters::add(counters.allocations, inserted.second));
+        }
+
+        if constexpr (keepsComments)
+        {
+            if (!line.comment.empty())
+            {
+                INI_STATS(IniStatsCounters::add(counters.allocations));
+                keyComments.try_emplace(section).first->second.edit().insert_or_assign(line.folded, std::move(line.comment));
+            }
+            if (!line.commentBlock.empty())
+                lazyComments.add(buffer, sectionName, line.name, line.commentBlock);
+        }
+
+        [[maybe_unused]] auto keyIt = keys->insert_or_assign(std::move(line.folded), line.value);
+        INI_STATS(IniStatsCounters::add(counters.allocations, keyIt.second));
+    }
+    if (keys != nullptr)
+        StoragePolicy::restoreOrder(*keys);
+    StoragePolicy::restoreOrder(data);
+
+    if constexpr (keepsComments)
+    {
+        if (comments == CommentMode::Lazy)
+            lazyComments.retain(std::move(buffer));
+    }
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::materializeComments() const
+{
+    if constexpr (keepsComments)
+    {
+        if (!lazyComments.pending())
+            return;
+
+        // con IniSharedLocking piu' lettori possono arrivare qui insieme: materialize li serializza e chi arriva
+        // dopo trova tutto gia' inserito
+        lazyComments.materialize([this](string_view section, const string_view* key, string_view comment)
+        {
+            if (key == nullptr)
+                sectionComments.insert_or_assign(folded(section), comment);
+            else
+                keyComments.try_emplace(folded(section)).first->second.edit().insert_or_assign(folded(*key), comment);
+        });
+    }
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::save(const string& name) const
+{
+    INI_STATS(IniStatsTimer timer(counters.saveNanos, counters.lastSaveNanos));
+    INI_STATS(IniStatsCounters::add(counters.saves));
+    IniTracer* tracer = IniTracer::installed();
+    IniTraceSpan saveSpan("IniFile::save", tracer);
+
+    shared_lock<Mutex> lock(mutex);
+    materializeComments();
+    IniTraceSpan openSpan("save.open", tracer);
+    ofstream file(name);    // apre il file in scrittura (sovrascrive il file se esiste)
+
+    if (!file.is_open())
+        throw runtime_error("Unable to open file for writing: " + name);
+    openSpan.end();
+
+    IniTraceSpan writeSpan("save.write", tracer);
+    forEachInOrder(data, [&](const auto& section)
+    {
+        if constexpr (keepsComments)
+        {
+            auto sectionComment = sectionComments.find(section.first);
+            if (sectionComment != sectionComments.end())
+                file << sectionComment->second;
+        }
+
+        file << '[' << section.first << ']' << '\n';
+
+        forEachInOrder(section.second.keys(), [&](const auto& key)
+        {
+            if constexpr (keepsComments)
+            {
+                auto keyCommentSection = keyComments.find(section.first);
+                if (keyCommentSection != keyComments.end())
+                {
+                    auto keyComment = keyCommentSection->second.find(key.first);
+                    if (keyComment != keyCommentSection->second.end())
+                        file << keyComment->second;
+                }
+            }
+            file << key.first << '=' << key.second << '\n';
+        });
+    });
+    INI_STATS(IniStatsCounters::add(counters.bytesWritten, static_cast<uint64_t>(file.tellp())));
+    writeSpan.end();
+
+    IniTraceSpan closeSpan("save.close", tracer);
+    file.close();   // svuota il buffer: gli errori di scrittura emergono qui
+
+    if (file.fail()) // controlla se ci sono stati errori durante la scrittura
+        throw runtime_error("Error writing to the file: " + name);
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::save() const
+{
+    string name;
+    {
+        shared_lock<Mutex> lock(mutex);
+        name = fileName;
+    }
+    save(name);
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+string BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::toLower(const string& str)
+{
+    string lowerStr = str;
+    transform(lowerStr.begin(), lowerStr.end(), lowerStr.begin(), ::tolower);
+    return lowerStr;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+const string& BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::foldForLookup(const string& str)
+{
+    // buffer per thread riusato: dopo la prima chiamata le ricerche non allocano piu'
+    thread_local string folded;
+    folded.assign(str);
+    transform(folded.begin(), folded.end(), folded.begin(), ::tolower);
+    return folded;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+auto BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::lookupKey(const string& name)
+    -> const LookupKey&
+{
+    // senza folding una std::string va gia' bene, altrimenti un buffer per thread riusato come foldForLookup
+    if constexpr (!CasePolicy::foldsCase && is_same_v<LookupKey, string>)
+        return name;
+    else
+    {
+        thread_local LookupKey buffer;
+        buffer.assign(name.data(), name.size());
+        CasePolicy::fold(buffer);
+        return buffer;
+    }
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+auto BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::lockBoth(const BasicIniFile& a,
+                                                                                              const BasicIniFile& b)
+    -> pair<shared_lock<Mutex>, shared_lock<Mutex>>
+{
+    // in ordine di indirizzo, e una volta sola se i file coincidono: due chiamate incrociate non si bloccano
+    const BasicIniFile* first = less<const BasicIniFile*>()(&a, &b) ? &a : &b;
+    const BasicIniFile* second = first == &a ? &b : &a;
+    shared_lock<Mutex> firstLock(first->mutex);
+    shared_lock<Mutex> secondLock = first == second ? shared_lock<Mutex>() : shared_lock<Mutex>(second->mutex);
+    return {std::move(firstLock), std::move(secondLock)};
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+auto BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::folded(string_view name) const -> String
+{
+    String result(name, get_allocator());
+    CasePolicy::fold(result);
+    return result;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+auto BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::find(const string& section,
+                                                                                          const string& key) const
+    -> const String*
+{
+    auto it = data.find(lookupKey(section));
+    if (it == data.end())
+        return nullptr;
+
+    auto it2 = it->second.find(lookupKey(key));
+    if (it2 == it->second.end())
+        return nullptr;
+
+    return &it2->second;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+string BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::get(const string& section,
+                                                                                           const string& key) const
+{
+    IniTraceSpan span("IniFile::get", IniTracer::sampled());
+    shared_lock<Mutex> lock(mutex);
+    const String* value = find(section, key);
+    INI_STATS(IniStatsCounters::add(value != nullptr ? counters.getHits : counters.getMisses));
+
+    return value != nullptr ? string(value->data(), value->size()) : "";
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+string BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::getResolved(const string& section,
+                                                                                                   const string& key) const
+{
+    shared_lock<Mutex> lock(mutex);
+    return interpolator.resolve(section, key, &CasePolicy::template fold<string>,
+                                [this](const string& sectionName, const string& keyName)
+                                {
+                                    const String* value = find(sectionName, keyName);
+                                    return value != nullptr ? string_view(*value) : string_view();
+                                });
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+string_view BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::getView(const string& section,
+                                                                                                    const string& key) const
+{
+    IniTraceSpan span("IniFile::getView", IniTracer::sampled());
+    shared_lock<Mutex> lock(mutex);
+    const String* value = find(section, key);
+    INI_STATS(IniStatsCounters::add(value != nullptr ? counters.getHits : counters.getMisses));
+
+    return value != nullptr ? string_view(*value) : string_view();
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::set(const string& section,
+                                                                                         const string& key, const string& value)
+{
+    IniTraceSpan span("IniFile::set", IniTracer::sampled());
+    unique_lock<Mutex> lock(mutex);
+    // se sezione o chiave non esistono vengono create
+    auto sectionIt = data.try_emplace(folded(section));
+    auto keyIt = sectionIt.first->second.edit().insert_or_assign(folded(key), value);
+    interpolator.invalidate(sectionIt.first->first, keyIt.first->first);
+    INI_STATS(IniStatsCounters::add(counters.sets));
+    INI_STATS(IniStatsCounters::add(counters.allocations, sectionIt.second + keyIt.second));
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::addSection(const string& section)
+{
+    unique_lock<Mutex> lock(mutex);
+    // se la sezione non esiste viene creata, altrimenti non fa nulla
+    [[maybe_unused]] auto sectionIt = data.try_emplace(folded(section));
+    INI_STATS(IniStatsCounters::add(counters.allocations, sectionIt.second));
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+bool BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::hasSection(const string& section) const
+{
+    shared_lock<Mutex> lock(mutex);
+    return data.find(lookupKey(section)) != data.end();
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+bool BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::hasKey(const string& section,
+                                                                                            const string& key) const
+{
+    shared_lock<Mutex> lock(mutex);
+    return find(section, key) != nullptr;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+vector<string> BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::hasKey(const string& key) const
+{
+    shared_lock<Mutex> lock(mutex);
+    const LookupKey& lowerKey = lookupKey(key);
+
+    vector<string> sections;
+    for (const auto& section : data)
+    {
+        if (section.second.find(lowerKey) != section.second.end())
+            sections.emplace_back(section.first.data(), section.first.size());
+    }
+
+    if (!StoragePolicy::inOrder(data))
+        sort(sections.begin(), sections.end());     // stesso ordine per ogni contenitore
+    return sections;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+auto BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::hasKey(const string& key,
+                                                                                            const Allocator& allocator) const
+    -> vector<String, typename allocator_traits<Allocator>::template rebind_alloc<String>>
+{
+    shared_lock<Mutex> lock(mutex);
+    const LookupKey& lowerKey = lookupKey(key);
+
+    vector<String, typename allocator_traits<Allocator>::template rebind_alloc<String>> sections(allocator);
+    for (const auto& section : data)
+    {
+        if (section.second.find(lowerKey) != section.second.end())
+            sections.emplace_back(section.first);   // con pmr la stringa riceve l'allocatore del vettore
+    }
+
+    if (!StoragePolicy::inOrder(data))
+        sort(sections.begin(), sections.end());
+    return sections;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+bool BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::deleteSection(const string& section)
+{
+    unique_lock<Mutex> lock(mutex);
+    auto it = data.find(lookupKey(section));
+    if (it == data.end())
+        return false;
+    interpolator.invalidateSection(it->first);
+    data.erase(it);
+    INI_STATS(IniStatsCounters::add(counters.deletes));
+    return true;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+bool BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::deleteKey(const string& section,
+                                                                                               const string& key)
+{
+    unique_lock<Mutex> lock(mutex);
+    auto it = data.find(lookupKey(section));
+    if (it == data.end())
+        return false;
+
+    auto it2 = it->second.find(lookupKey(key));
+    if (it2 == it->second.end())
+        return false;
+
+    interpolator.invalidate(it->first, it2->first);
+    Keys& keys = it->second.edit();     // se la sezione era condivisa ora e' una copia: si cerca di nuovo
+    keys.erase(keys.find(it2->first));
+    INI_STATS(IniStatsCounters::add(counters.deletes));
+    return true;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+bool BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::setSectionComment(const string& section,
+                                                                                                       const string& comment)
+{
+    if constexpr (keepsComments)
+    {
+        unique_lock<Mutex> lock(mutex);
+        if (data.find(lookupKey(section)) == data.end())
+            return false;
+
+        materializeComments();      // altrimenti un commento pendente sovrascriverebbe quello nuovo
+        [[maybe_unused]] auto commentIt = sectionComments.insert_or_assign(folded(section), comment);
+        INI_STATS(IniStatsCounters::add(counters.allocations, commentIt.second));
+        return true;
+    }
+    else
+        return false;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+bool BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::setKeyComment(const string& section,
+                                                                                                   const string& key,
+                                                                                                   const string& comment)
+{
+    if constexpr (keepsComments)
+    {
+        unique_lock<Mutex> lock(mutex);
+        if (find(section, key) == nullptr)
+            return false;
+
+        materializeComments();
+        auto sectionIt = keyComments.try_emplace(folded(section));
+        [[maybe_unused]] auto commentIt = sectionIt.first->second.edit().insert_or_assign(folded(key), comment);
+        INI_STATS(IniStatsCounters::add(counters.allocations, sectionIt.second + commentIt.second));
+        return true;
+    }
+    else
+        return false;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+template <typename Output>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::printTo(Output& output,
+                                                                                             bool print_comments) const
+{
+    IniTracer* tracer = IniTracer::installed();
+    IniTraceSpan printSpan("IniFile::print", tracer);
+    if (print_comments)
+        materializeComments();
+
+    // prima si calcola un limite superiore della dimensione, cosi' l'output viene allocato una volta sola
+    IniTraceSpan measureSpan("print.measure", tracer);
+    size_t size = 0;
+    for (const auto& section : data)
+    {
+        size += section.first.size() + 3;
+        for (const auto& key : section.second)
+            size += key.first.size() + key.second.size() + 2;
+    }
+    if constexpr (keepsComments)
+    {
+        if (print_comments)
+        {
+            for (const auto& comment : sectionComments)
+                size += comment.second.size();
+            for (const auto& section : keyComments)
+            {
+                for (const auto& comment : section.second)
+                    size += comment.second.size();
+            }
+        }
+    }
+    measureSpan.end();
+
+    IniTraceSpan formatSpan("print.format", tracer);
+    output.reserve(size);
+
+    forEachInOrder(data, [&](const auto& section)
+    {
+        if constexpr (keepsComments)
+        {
+            if (print_comments)
+            {
+                auto sectionComment = sectionComments.find(section.first);
+                if (sectionComment != sectionComments.end())
+                    output.append(sectionComment->second.data(), sectionComment->second.size());
+            }
+        }
+
+        output.append(1, '[').append(section.first.data(), section.first.size()).append("]\n");
+
+        forEachInOrder(section.second.keys(), [&](const auto& key)
+        {
+            if constexpr (keepsComments)
+            {
+                if (print_comments)
+                {
+                    auto keyCommentSection = keyComments.find(section.first);
+                    if (keyCommentSection != keyComments.end())
+                    {
+                        auto keyComment = keyCommentSection->second.find(key.first);
+                        if (keyComment != keyCommentSection->second.end())
+                            output.append(keyComment->second.data(), keyComment->second.size());
+                    }
+                }
+            }
+            output.append(key.first.data(), key.first.size()).append(1, '=')
+                  .append(key.second.data(), key.second.size()).append(1, '\n');
+        });
+    });
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+template <typename Map, typename Visit>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::forEachInOrder(const Map& map,
+                                                                                                    Visit&& visit)
+{
+    if (!StoragePolicy::sorted || StoragePolicy::inOrder(map))
+    {
+        for (const auto& item : map)
+            visit(item);
+        return;
+    }
+
+    // chi legge non puo' riordinare il contenitore, magari condiviso con altre copie: si ordinano dei puntatori
+    vector<const typename Map::value_type*> items;
+    items.reserve(map.size());
+    for (const auto& item : map)
+        items.push_back(&item);
+    sort(items.begin(), items.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+    for (const auto* item : items)
+        visit(*item);
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+string BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::print(bool print_comments) const
+{
+    shared_lock<Mutex> lock(mutex);
+    string output;
+    printTo(output, print_comments);
+    return output;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+auto BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::print(bool print_comments,
+                                                                                           const Allocator& allocator) const
+    -> String
+{
+    shared_lock<Mutex> lock(mutex);
+    String output(allocator);
+    printTo(output, print_comments);
+    return output;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+string BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::getSectionComment(const string& section) const
+{
+    if constexpr (keepsComments)
+    {
+        shared_lock<Mutex> lock(mutex);
+        materializeComments();
+        auto it = sectionComments.find(lookupKey(section));
+        if (it == sectionComments.end())
+            return "";
+
+        return string(it->second.data(), it->second.size());
+    }
+    else
+        return "";
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+string BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::getKeyComment(const string& section,
+                                                                                                     const string& key) const
+{
+    if constexpr (keepsComments)
+    {
+        shared_lock<Mutex> lock(mutex);
+        materializeComments();
+        auto it = keyComments.find(lookupKey(section));
+        if (it == keyComments.end())
+            return "";
+
+        auto it2 = it->second.find(lookupKey(key));
+        if (it2 == it->second.end())
+            return "";
+
+        return string(it2->second.data(), it2->second.size());
+    }
+    else
+        return "";
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+vector<IniChange> BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::diff(const BasicIniFile& from,
+                                                                                                       const BasicIniFile& to)
+{
+    vector<IniChange> changes;
+    if (&from == &to)
+        return changes;
+    auto locks = lockBoth(from, to);
+
+    auto addAll = [&changes](IniChange::Type type, string_view section, const Keys& keys)
+    {
+        for (const auto& key : keys)
+        {
+            if (type == IniChange::Type::Added)
+                changes.push_back({type, section, key.first, "", key.second});
+            else
+                changes.push_back({type, section, key.first, key.second, ""});
+        }
+    };
+
+    auto sortFrom = [&changes](size_t first)    // modifiche di una sola sezione, ordinate per chiave
+    {
+        sort(changes.begin() + static_cast<ptrdiff_t>(first), changes.end(),
+             [](const IniChange& a, const IniChange& b) { return a.key < b.key; });
+    };
+
+    // senza ordine si cerca ogni nome nell'altra sezione; chi chiama ordina le modifiche
+    auto lookupKeys = [&changes](string_view section, const Section& oldKeys, const Section& newKeys)
+    {
+        for (const auto& oldKey : oldKeys)
+        {
+            auto newKey = newKeys.find(oldKey.first);
+            if (newKey == newKeys.end())
+                changes.push_back({IniChange::Type::Removed, section, oldKey.first, oldKey.second, ""});
+            else if (oldKey.second != newKey->second)
+                changes.push_back({IniChange::Type::Modified, section, oldKey.first, oldKey.second, newKey->second});
+        }
+        for (const auto& newKey : newKeys)
+        {
+            if (oldKeys.find(newKey.first) == oldKeys.end())
+                changes.push_back({IniChange::Type::Added, section, newKey.first, "", newKey.second});
+        }
+    };
+
+    if (StoragePolicy::sorted && StoragePolicy::inOrder(from.data) && StoragePolicy::inOrder(to.data))
+    {
+        // le mappe sono ordinate: basta un'unica passata di merge su sezioni e chiavi
+        auto oldSection = from.data.begin();
+        auto newSection = to.data.begin();
+        while (oldSection != from.data.end() || newSection != to.data.end())
+        {
+            if (newSection == to.data.end() || (oldSection != from.data.end() && oldSection->first < newSection->first))
+            {
+                size_t first = changes.size();
+                addAll(IniChange::Type::Removed, oldSection->first, oldSection->second.keys());
+                if (!StoragePolicy::inOrder(oldSection->second.keys()))
+                    sortFrom(first);
+                ++oldSection;
+                continue;
+            }
+
+            if (oldSection == from.data.end() || newSection->first < oldSection->first)
+            {
+                size_t first = changes.size();
+                addAll(IniChange::Type::Added, newSection->first, newSection->second.keys());
+                if (!StoragePolicy::inOrder(newSection->second.keys()))
+                    sortFrom(first);
+                ++newSection;
+                continue;
+            }
+
+            if (oldSection->second.shares(newSection->second))     // sezione mai toccata dopo la copia
+            {
+                ++oldSection;
+                ++newSection;
+                continue;
+            }
+
+            const String& section = oldSection->first;
+            if (!StoragePolicy::inOrder(oldSection->second.keys()) || !StoragePolicy::inOrder(newSection->second.keys()))
+            {
+                size_t first = changes.size();
+                lookupKeys(section, oldSection->second, newSection->second);
+                sortFrom(first);
+                ++oldSection;
+                ++newSection;
+                continue;
+            }
+
+            auto oldKey = oldSection->second.begin();
+            auto newKey = newSection->second.begin();
+            while (oldKey != oldSection->second.end() || newKey != newSection->second.end())
+            {
+                if (newKey == newSection->second.end() || (oldKey != oldSection->second.end() && oldKey->first < newKey->first))
+                {
+                    changes.push_back({IniChange::Type::Removed, section, oldKey->first, oldKey->second, ""});
+                    ++oldKey;
+                }
+                else if (oldKey == oldSection->second.end() || newKey->first < oldKey->first)
+                {
+                    changes.push_back({IniChange::Type::Added, section, newKey->first, "", newKey->second});
+                    ++newKey;
+                }
+                else
+                {
+                    if (oldKey->second != newKey->second)
+                        changes.push_back({IniChange::Type::Modified, section, oldKey->first, oldKey->second, newKey->second});
+                    ++oldKey;
+                    ++newKey;
+                }
+            }
+
+            ++oldSection;
+            ++newSection;
+        }
+    }
+    else
+    {
+        // senza ordine si cerca ogni nome nell'altro file e alla fine si ordina come nel caso precedente
+        for (const auto& oldSection : from.data)
+        {
+            auto newSection = to.data.find(oldSection.first);
+            if (newSection == to.data.end())
+            {
+                addAll(IniChange::Type::Removed, oldSection.first, oldSection.second.keys());
+                continue;
+            }
+            if (!oldSection.second.shares(newSection->second))
+                lookupKeys(oldSection.first, oldSection.second, newSection->second);
+        }
+        for (const auto& newSection : to.data)
+        {
+            if (from.data.find(newSection.first) == from.data.end())
+                addAll(IniChange::Type::Added, newSection.first, newSection.second.keys());
+        }
+
+        sort(changes.begin(), changes.end(), [](const IniChange& a, const IniChange& b)
+        {
+            return tie(a.section, a.key) < tie(b.section, b.key);
+        });
+    }
+
+    return changes;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+size_t BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::sharedSections(const BasicIniFile& other) const
+{
+    auto locks = lockBoth(*this, other);
+    size_t shared = 0;
+    for (const auto& section : data)
+    {
+        auto it = other.data.find(section.first);
+        if (it != other.data.end() && it->second.shares(section.second))
+            shared++;
+    }
+
+    return shared;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+IniFileStats BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::stats() const
+{
+    shared_lock<Mutex> lock(mutex);
+    IniFileStats result;
+    INI_STATS(counters.fill(result));
+
+    // il contenuto si ricava dalle mappe, cosi' resta corretto anche per le modifiche fatte dalle classi amiche
+    result.sections = data.size();
+    result.resolvedValues = interpolator.size();
+    result.resolvedReferences = interpolator.references();
+    for (const auto& section : data)
+    {
+        result.keys += section.second.size();
+        result.bytes += section.first.size();
+        for (const auto& key : section.second)
+            result.bytes += key.first.size() + key.second.size();
+    }
+    if constexpr (keepsComments)
+    {
+        for (const auto& comment : sectionComments)
+            result.bytes += comment.second.size();
+        for (const auto& section : keyComments)
+        {
+            for (const auto& comment : section.second)
+                result.bytes += comment.second.size();
+        }
+    }
+
+    return result;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+IniMemoryUsage BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::memoryUsage() const
+{
+    shared_lock<Mutex> lock(mutex);
+    IniMemoryUsage result;
+    StoragePolicy::addContainer(data, result.total);
+    // le chiavi di una sezione stanno in un blocco a parte; se e' condiviso con altre copie viene contato in ognuna
+    auto sectionNodeBytes = [](const Section& section)
+    {
+        return StoragePolicy::template nodeBytes<Sections> + (section.allocated() ? Section::sharedBlockBytes : 0);
+    };
+
+    for (const auto& section : data)
+    {
+        IniMemoryFootprint& footprint = result.sections[string(section.first.data(), section.first.size())];
+        footprint.addNode(sectionNodeBytes(section.second), footprint.data, section.first);
+        StoragePolicy::addContainer(section.second.keys(), footprint);
+        for (const auto& key : section.second)
+            footprint.addNode(StoragePolicy::template nodeBytes<Keys>, footprint.data, key.first, key.second);
+    }
+
+    if constexpr (keepsComments)
+    {
+        // i commenti di sezioni che non esistono piu' finiscono solo nel totale
+        StoragePolicy::addContainer(sectionComments, result.total);
+        StoragePolicy::addContainer(keyComments, result.total);
+        IniMemoryFootprint orphans;
+        auto sectionFootprint = [&](const String& name) -> IniMemoryFootprint&
+        {
+            auto it = result.sections.find(string(name.data(), name.size()));
+            return it != result.sections.end() ? it->second : orphans;
+        };
+
+        for (const auto& comment : sectionComments)
+        {
+            IniMemoryFootprint& footprint = sectionFootprint(comment.first);
+            footprint.addNode(StoragePolicy::template nodeBytes<Keys>, footprint.comments, comment.first, comment.second);
+        }
+        for (const auto& section : keyComments)
+        {
+            IniMemoryFootprint& footprint = sectionFootprint(section.first);
+            footprint.addNode(sectionNodeBytes(section.second), footprint.comments, section.first);
+            StoragePolicy::addContainer(section.second.keys(), footprint);
+            for (const auto& comment : section.second)
+                footprint.addNode(StoragePolicy::template nodeBytes<Keys>, footprint.comments, comment.first, comment.second);
+        }
+        result.total += orphans;
+    }
+
+    for (const auto& section : result.sections)
+        result.total += section.second;
+    if constexpr (keepsComments)
+    {
+        result.retainedBuffer = lazyComments.memoryUsage();
+        result.total.comments += result.retainedBuffer;
+    }
+    return result;
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::resetStats()
+{
+    INI_STATS(counters.reset());
+}
+
+#endif //INIMANAGER_BASICINIFILE_H
@@ -0,0 +1,154 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "ChangeNotifier.h"
+
+ChangeNotifier::Executor ChangeNotifier::inlineExecutor()
+{
+    return [](function<void()> task) { task(); };
+}
+
+size_t ChangeNotifier::subscribe(Callback callback, Executor executor)
+{
+    return add({0, "", "", std::move(callback), std::move(executor)});
+}
+
+size_t ChangeNotifier::subscribeSection(const string& section, Callback callback, Executor executor)
+{
+    string lowerSection = section;
+    transform(lowerSection.begin(), lowerSection.end(), lowerSection.begin(), ::tolower);
+    return add({0, lowerSection, "", std::move(callback), std::move(executor)});
+}
+
+size_t ChangeNotifier::subscribeKey(const string& section, const string& key, Callback callback, Executor executor)
+{
+    string lowerSection = section;
+    string lowerKey = key;
+    transform(lowerSection.begin(), lowerSection.end(), lowerSection.begin(), ::tolower);
+    transform(lowerKey.begin(), lowerKey.end(), lowerKey.begin(), ::tolower);
+    return add({0, lowerSection, lowerKey, std::move(callback), std::move(executor)});
+}
+
+bool ChangeNotifier::unsubscribe(size_t id)
+{
+    lock_guard<mutex> lock(subscriptionsMutex);
+
+    auto updated = make_shared<vector<Subscription>>(*subscriptions);
+    auto it = find_if(updated->begin(), updated->end(), [id](const Subscription& s) { return s.id == id; });
+    if (it == updated->end())
+        return false;
+
+    updated->erase(it);
+    subscriptions = updated;
+    subscriptionCount.store(updated->size(), memory_order_relaxed);
+    return true;
+}
+
+bool ChangeNotifier::empty() const
+{
+    return subscriptionCount.load(memory_order_relaxed) == 0;
+}
+
+void ChangeNotifier::publish(const vector<IniChange>& changes) const
+{
+    if (changes.empty() || empty())
+        return;
+
+    shared_ptr<const vector<Subscription>> current;
+    {
+        lock_guard<mutex> lock(subscriptionsMutex);
+        current = subscriptions;    // le callback vengono eseguite senza tenere il lock
+    }
+
+    for (const auto& subscription : *current)
+    {
+        vector<IniChange> batch;
+        if (subscription.section.empty())
+        {
+            batch = changes;
+        }
+        else
+        {
+            for (const auto& change : changes)
+            {
+                if (change.section == subscription.section && (subscription.key.empty() || change.key == subscription.key))
+                    batch.push_back(change);
+            }
+        }
+
+        if (batch.empty())
+            continue;
+
+        subscription.executor([callback = subscription.callback, batch = std::move(batch)] { callback(batch); });
+    }
+}
+
+size_t ChangeNotifier::add(Subscription subscription)
+{
+    lock_guard<mutex> lock(subscriptionsMutex);
+
+    subscription.id = nextId++;
+    auto updated = make_shared<vector<Subscription>>(*subscriptions);
+    updated->push_back(std::move(subscription));
+    subscriptions = updated;
+    subscriptionCount.store(updated->size(), memory_order_relaxed);
+    return updated->back().id;
+}
+
+SerialExecutor::SerialExecutor() : worker(&SerialExecutor::run, this)
+{
+}
+
+SerialExecutor::~SerialExecutor()
+{
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    worker.join();
+}
+
+ChangeNotifier::Executor SerialExecutor::executor()
+{
+    return [this](function<void()> task) { post(std::move(task)); };
+}
+
+void SerialExecutor::post(function<void()> task)
+{
+    {
+        lock_guard<mutex> lock(queueMutex);
+        tasks.push_back(std::move(task));
+    }
+    queueCondition.notify_one();
+}
+
+void SerialExecutor::drain()
+{
+    unique_lock<mutex> lock(queueMutex);
+    idleCondition.wait(lock, [this] { return tasks.empty() && !running; });
+}
+
+void SerialExecutor::run()
+{
+    unique_lock<mutex> lock(queueMutex);
+    while (true)
+    {
+        queueCondition.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+            break;      // stopping, e non c'e' piu' nulla da eseguire
+
+        function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        running = true;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        running = false;
+        if (tasks.empty())
+            idleCondition.notify_all();
+    }
+}
@@ -0,0 +1,77 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_CHANGENOTIFIER_H
+#define INIMANAGER_CHANGENOTIFIER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "IniFile.h"
+
+// Distribuisce le modifiche a chi si e' iscritto su una chiave, una sezione o l'intero file.
+// Ogni iscritto riceve un unico batch per modifica, consegnato tramite il proprio executor.
+class ChangeNotifier
+{
+    public:
+        using Executor = function<void(function<void()>)>;
+        using Callback = function<void(const vector<IniChange>&)>;
+
+        static Executor inlineExecutor();
+
+        size_t subscribe(Callback callback, Executor executor = inlineExecutor());
+        size_t subscribeSection(const string& section, Callback callback, Executor executor = inlineExecutor());
+        size_t subscribeKey(const string& section, const string& key, Callback callback, Executor executor = inlineExecutor());
+        bool unsubscribe(size_t id);
+        bool empty() const;
+        void publish(const vector<IniChange>& changes) const;
+
+    private:
+        struct Subscription
+        {
+            size_t id;
+            string section;     // vuota: tutto il file
+            string key;         // vuota: tutta la sezione
+            Callback callback;
+            Executor executor;
+        };
+
+        mutable mutex subscriptionsMutex;
+        shared_ptr<const vector<Subscription>> subscriptions = make_shared<vector<Subscription>>();
+        atomic<size_t> subscriptionCount{0};
+        size_t nextId = 1;
+
+        size_t add(Subscription subscription);
+};
+
+// Executor con un unico thread dedicato: le notifiche vengono eseguite in ordine, fuori dai lock di chi scrive.
+class SerialExecutor
+{
+    public:
+        SerialExecutor();
+        ~SerialExecutor();
+        SerialExecutor(const SerialExecutor&) = delete;
+        SerialExecutor& operator=(const SerialExecutor&) = delete;
+
+        ChangeNotifier::Executor executor();
+        void post(function<void()> task);
+        void drain();
+
+    private:
+        mutex queueMutex;
+        condition_variable queueCondition;
+        condition_variable idleCondition;
+        deque<function<void()>> tasks;
+        bool running = false;
+        bool stopping = false;
+        thread worker;
+
+        void run();
+};
+
+#endif //INIMANAGER_CHANGENOTIFIER_H
@@ -0,0 +1,79 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "ChromeTraceWriter.h"
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+ChromeTraceWriter::ChromeTraceWriter(string fileName) : fileName(std::move(fileName)), start(chrono::steady_clock::now())
+{
+}
+
+ChromeTraceWriter::~ChromeTraceWriter()
+{
+    try
+    {
+        flush();
+    }
+    catch (const exception& e)
+    {
+        cerr << "Error writing trace file: " << e.what() << endl;
+    }
+}
+
+void ChromeTraceWriter::beginSpan(const char* name)
+{
+    record(name, 'B');
+}
+
+void ChromeTraceWriter::endSpan(const char* name)
+{
+    record(name, 'E');
+}
+
+void ChromeTraceWriter::record(const char* name, char phase)
+{
+    int64_t nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    static atomic<uint64_t> nextThread{1};
+    thread_local uint64_t thread = nextThread++;     // id piccoli e stabili, piu' leggibili nel viewer
+
+    lock_guard<mutex> lock(eventsMutex);
+    events.push_back({name, phase, nanos, thread});
+}
+
+void ChromeTraceWriter::flush()
+{
+    lock_guard<mutex> lock(eventsMutex);
+
+    ofstream file(fileName);
+    if (!file.is_open())
+        throw runtime_error("Unable to open file for writing: " + fileName);
+
+    // i nomi sono letterali del codice, quindi non servono sequenze di escape
+    file << "{\"traceEvents\":[";
+    file << fixed << setprecision(3);
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const Event& event = events[i];
+        file << (i == 0 ? "\n" : ",\n")
+             << "{\"name\":\"" << event.name << "\",\"cat\":\"inimanager\",\"ph\":\"" << event.phase
+             << "\",\"ts\":" << static_cast<double>(event.nanos) / 1000
+             << ",\"pid\":" << getpid() << ",\"tid\":" << event.thread << '}';
+    }
+    file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    file.close();
+    if (file.fail())
+        throw runtime_error("Error writing to the file: " + fileName);
+}
+
+size_t ChromeTraceWriter::eventCount() const
+{
+    lock_guard<mutex> lock(eventsMutex);
+    return events.size();
+}
@@ -0,0 +1,47 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_CHROMETRACEWRITER_H
+#define INIMANAGER_CHROMETRACEWRITER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "IniTracer.h"
+
+using namespace std;
+
+// Tracer che raccoglie gli span in memoria e li scrive nel formato JSON "trace event" di Chrome,
+// apribile con chrome://tracing o https://ui.perfetto.dev. Il file viene scritto da flush() o dal distruttore.
+class ChromeTraceWriter : public IniTracer
+{
+    public:
+        explicit ChromeTraceWriter(string fileName);
+        ~ChromeTraceWriter() override;
+
+        void beginSpan(const char* name) override;
+        void endSpan(const char* name) override;
+
+        void flush();
+        size_t eventCount() const;
+
+    private:
+        struct Event
+        {
+            const char* name;
+            char phase;         // 'B' inizio, 'E' fine
+            int64_t nanos;      // dall'avvio del writer
+            uint64_t thread;
+        };
+
+        string fileName;
+        chrono::steady_clock::time_point start;
+        mutable mutex eventsMutex;
+        vector<Event> events;
+
+        void record(const char* name, char phase);
+};
+
+#endif //INIMANAGER_CHROMETRACEWRITER_H
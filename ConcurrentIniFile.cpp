@@ -0,0 +1,491 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "ConcurrentIniFile.h"
+
+ConcurrentIniFile::ConcurrentIniFile(string name) : fileName(std::move(name))
+{
+    try
+    {
+        load(fileName);
+    }
+    catch (const exception& e)
+    {
+        cerr << "Error loading INI file: " << e.what() << endl;
+    }
+}
+
+void ConcurrentIniFile::load(const string& name)
+{
+    IniFile ini;
+    ini.load(name);     // il parsing avviene senza lock, poi si sostituisce il contenuto in un colpo solo
+
+    // gli shard vengono bloccati sempre nello stesso ordine per evitare deadlock
+    vector<unique_lock<shared_mutex>> locks;
+    for (auto& shard : shards)
+        locks.emplace_back(shard.mutex);
+
+    vector<IniChange> loadChanges;
+    if (!changes.empty())
+        loadChanges = IniFile::diff(snapshotLocked(), ini);
+
+    array<map<string, unique_ptr<Section>>, shardCount> loaded;
+    array<map<string, string>, shardCount> pendingComments;
+    for (auto& comment : ini.sectionComments)
+    {
+        // la sezione senza chiavi non esiste ancora, ma il commento resta per quando verra' creata
+        if (ini.data.find(comment.first) == ini.data.end())
+            pendingComments[&shardFor(comment.first) - shards.data()].emplace(string(comment.first), string(comment.second));
+    }
+
+    for (auto& section : ini.data)
+    {
+        auto newSection = make_unique<Section>();
+        newSection->keys = section.second.take();
+
+        auto keyComments = ini.keyComments.find(section.first);
+        if (keyComments != ini.keyComments.end())
+            newSection->keyComments = keyComments->second.take();
+
+        auto comment = ini.sectionComments.find(section.first);
+        if (comment != ini.sectionComments.end())
+            newSection->comment = comment->second;
+
+        loaded[&shardFor(section.first) - shards.data()].emplace(section.first, std::move(newSection));
+    }
+
+    for (size_t i = 0; i < shardCount; i++)
+    {
+        shards[i].sections.swap(loaded[i]);
+        shards[i].pendingComments.swap(pendingComments[i]);
+    }
+
+    {
+        lock_guard<mutex> lock(fileNameMutex);
+        fileName = name;
+    }
+
+    bool notify = enqueueChanges(std::move(loadChanges));
+    locks.clear();
+    if (notify)
+        publishChanges();
+}
+
+void ConcurrentIniFile::save(const string& name) const
+{
+    snapshot().save(name);
+}
+
+void ConcurrentIniFile::save() const
+{
+    string name;
+    {
+        lock_guard<mutex> lock(fileNameMutex);
+        name = fileName;
+    }
+    save(name);
+}
+
+string ConcurrentIniFile::get(const string& section, const string& key) const
+{
+    string lowerSection = IniFile::toLower(section);
+    string lowerKey = IniFile::toLower(key);
+
+    const Shard& shard = shardFor(lowerSection);
+    shared_lock<shared_mutex> shardLock(shard.mutex);
+    auto it = shard.sections.find(lowerSection);
+    if (it == shard.sections.end())
+        return "";
+
+    shared_lock<shared_mutex> sectionLock(it->second->mutex);
+    auto it2 = it->second->keys.find(lowerKey);
+    if (it2 == it->second->keys.end())
+        return "";
+
+    return string(it2->second);
+}
+
+void ConcurrentIniFile::set(const string& section, const string& key, const string& value)
+{
+    string lowerSection = IniFile::toLower(section);
+    string lowerKey = IniFile::toLower(key);
+
+    Shard& shard = shardFor(lowerSection);
+    IniChange change{IniChange::Type::Added, lowerSection, lowerKey, "", value};
+
+    bool notify = false;
+    auto assign = [this, &change, &lowerKey, &value, &notify](Section& section)
+    {
+        auto inserted = section.keys.try_emplace(IniFile::String(lowerKey), value);
+        if (!inserted.second)
+        {
+            change.type = IniChange::Type::Modified;
+            change.oldValue = std::move(inserted.first->second);
+            inserted.first->second = value;
+        }
+        if (!changes.empty() && (change.type == IniChange::Type::Added || change.oldValue != value))
+            notify = enqueueChanges({change});
+    };
+
+    bool assigned = false;
+    {
+        shared_lock<shared_mutex> shardLock(shard.mutex);
+        auto it = shard.sections.find(lowerSection);
+        if (it != shard.sections.end())
+        {
+            unique_lock<shared_mutex> sectionLock(it->second->mutex);
+            assign(*it->second);
+            assigned = true;
+        }
+    }
+
+    if (!assigned)
+    {
+        // la sezione non esiste: serve il lock strutturale in esclusiva per crearla
+        unique_lock<shared_mutex> shardLock(shard.mutex);
+        auto& created = shard.sections[lowerSection];
+        if (!created)
+        {
+            created = make_unique<Section>();
+            adoptComment(shard, lowerSection, *created);
+        }
+        assign(*created);   // con lo shard in esclusiva nessun altro vede la sezione
+    }
+
+    // la notifica parte solo dopo aver rilasciato i lock
+    if (notify)
+        publishChanges();
+}
+
+void ConcurrentIniFile::addSection(const string& section)
+{
+    string lowerSection = IniFile::toLower(section);
+
+    Shard& shard = shardFor(lowerSection);
+    unique_lock<shared_mutex> shardLock(shard.mutex);
+    auto& created = shard.sections[lowerSection];
+    if (!created)
+    {
+        created = make_unique<Section>();
+        adoptComment(shard, lowerSection, *created);
+    }
+}
+
+bool ConcurrentIniFile::hasSection(const string& section) const
+{
+    string lowerSection = IniFile::toLower(section);
+
+    const Shard& shard = shardFor(lowerSection);
+    shared_lock<shared_mutex> shardLock(shard.mutex);
+    return shard.sections.find(lowerSection) != shard.sections.end();
+}
+
+bool ConcurrentIniFile::hasKey(const string& section, const string& key) const
+{
+    string lowerSection = IniFile::toLower(section);
+    string lowerKey = IniFile::toLower(key);
+
+    const Shard& shard = shardFor(lowerSection);
+    shared_lock<shared_mutex> shardLock(shard.mutex);
+    auto it = shard.sections.find(lowerSection);
+    if (it == shard.sections.end())
+        return false;
+
+    shared_lock<shared_mutex> sectionLock(it->second->mutex);
+    return it->second->keys.find(lowerKey) != it->second->keys.end();
+}
+
+vector<string> ConcurrentIniFile::hasKey(const string& key) const
+{
+    string lowerKey = IniFile::toLower(key);
+
+    vector<string> result;
+    for (const auto& shard : shards)
+    {
+        shared_lock<shared_mutex> shardLock(shard.mutex);
+        for (const auto& section : shard.sections)
+        {
+            shared_lock<shared_mutex> sectionLock(section.second->mutex);
+            if (section.second->keys.find(lowerKey) != section.second->keys.end())
+                result.push_back(section.first);
+        }
+    }
+
+    sort(result.begin(), result.end());     // stesso ordine restituito da IniFile::hasKey
+    return result;
+}
+
+bool ConcurrentIniFile::deleteSection(const string& section)
+{
+    string lowerSection = IniFile::toLower(section);
+
+    Shard& shard = shardFor(lowerSection);
+    unique_ptr<Section> removed;
+    bool notify = false;
+    {
+        unique_lock<shared_mutex> shardLock(shard.mutex);
+        auto it = shard.sections.find(lowerSection);
+        if (it == shard.sections.end())
+            return false;
+
+        removed = std::move(it->second);
+        shard.sections.erase(it);
+
+        // la sezione non e' piu' raggiungibile da altri thread: la si puo' leggere senza il suo lock
+        if (!changes.empty())
+        {
+            vector<IniChange> removedKeys;
+            for (const auto& key : removed->keys)
+                removedKeys.push_back({IniChange::Type::Removed, lowerSection, key.first, key.second, ""});
+            notify = enqueueChanges(std::move(removedKeys));
+        }
+    }
+
+    if (notify)
+        publishChanges();
+    return true;
+}
+
+bool ConcurrentIniFile::deleteKey(const string& section, const string& key)
+{
+    string lowerSection = IniFile::toLower(section);
+    string lowerKey = IniFile::toLower(key);
+
+    Shard& shard = shardFor(lowerSection);
+    IniChange change{IniChange::Type::Removed, lowerSection, lowerKey, "", ""};
+    bool notify = false;
+    {
+        shared_lock<shared_mutex> shardLock(shard.mutex);
+        auto it = shard.sections.find(lowerSection);
+        if (it == shard.sections.end())
+            return false;
+
+        unique_lock<shared_mutex> sectionLock(it->second->mutex);
+        auto key = it->second->keys.find(lowerKey);
+        if (key == it->second->keys.end())
+            return false;
+
+        change.oldValue = std::move(key->second);
+        it->second->keys.erase(key);
+        auto comment = it->second->keyComments.find(lowerKey);
+        if (comment != it->second->keyComments.end())
+            it->second->keyComments.erase(comment);
+
+        if (!changes.empty())
+            notify = enqueueChanges({change});
+    }
+
+    if (notify)
+        publishChanges();
+    return true;
+}
+
+void ConcurrentIniFile::commit(const IniTransaction& transaction)
+{
+    vector<IniTransaction::SectionOperation> plan = transaction.plan();
+
+    // si bloccano in esclusiva solo gli shard coinvolti, in ordine crescente: i lettori di quegli
+    // shard attendono la fine del commit e non vedono mai uno stato intermedio
+    vector<size_t> involved;
+    for (const auto& operation : plan)
+        involved.push_back(&shardFor(operation.section) - shards.data());
+    sort(involved.begin(), involved.end());
+    involved.erase(unique(involved.begin(), involved.end()), involved.end());
+
+    vector<IniChange> commitChanges;
+    vector<IniChange>* changesOut = changes.empty() ? nullptr : &commitChanges;
+    bool notify = false;
+    {
+        vector<unique_lock<shared_mutex>> locks;
+        for (size_t index : involved)
+            locks.emplace_back(shards[index].mutex);
+
+        // fase 1: tutto cio' che alloca
+        vector<pair<Shard*, map<string, unique_ptr<Section>>::node_type>> newSections;
+        vector<pair<Section*, IniFile::Keys>> replacements;
+        vector<IniTransaction::PreparedKeys<IniFile::Keys>> prepared;
+        vector<pair<Section*, const IniTransaction::SectionOperation*>> edited;
+        vector<pair<Shard*, map<string, unique_ptr<Section>>::iterator>> erased;
+
+        for (const auto& operation : plan)
+        {
+            Shard& shard = shardFor(operation.section);
+            auto it = shard.sections.find(operation.section);
+
+            if (operation.eraseSection)
+            {
+                if (it == shard.sections.end())
+                    continue;
+
+                if (changesOut != nullptr)
+                {
+                    for (const auto& key : it->second->keys)
+                        changesOut->push_back({IniChange::Type::Removed, operation.section, key.first, key.second, ""});
+                }
+                erased.emplace_back(&shard, it);
+            }
+            else if (it == shard.sections.end())
+            {
+                auto keys = IniTransaction::buildSection<IniFile::Keys>(operation, nullptr, changesOut,
+                                                                        pmr::get_default_resource());
+                if (keys.empty())
+                    continue;
+
+                map<string, unique_ptr<Section>> node;
+                auto created = node.emplace(operation.section, make_unique<Section>()).first;
+                created->second->keys = std::move(keys);
+                newSections.emplace_back(&shard, node.extract(created));
+            }
+            else if (operation.replace)
+            {
+                replacements.emplace_back(it->second.get(), IniTransaction::buildSection(operation, &it->second->keys, changesOut,
+                                                                                     it->second->keys.get_allocator()));
+            }
+            else
+            {
+                prepared.emplace_back(it->second->keys, operation, changesOut);
+                edited.emplace_back(it->second.get(), &operation);
+            }
+        }
+
+        // fase 2: solo operazioni che non possono fallire
+        for (auto& keys : prepared)
+            keys.apply();
+        for (auto& replacement : replacements)
+            replacement.first->keys.swap(replacement.second);
+        for (auto& section : erased)
+            section.first->sections.erase(section.second);
+        for (auto& section : newSections)
+        {
+            auto inserted = section.first->sections.insert(std::move(section.second));
+            adoptComment(*section.first, inserted.position->first, *inserted.position->second);
+        }
+
+        // i commenti delle chiavi cancellate se ne vanno con le chiavi, come in deleteKey
+        for (const auto& section : edited)
+        {
+            IniFile::Keys& keyComments = section.first->keyComments;
+            for (const auto& key : section.second->keys)
+            {
+                auto comment = key.erase ? keyComments.find(key.key) : keyComments.end();
+                if (comment != keyComments.end())
+                    keyComments.erase(comment);
+            }
+        }
+        for (const auto& replacement : replacements)
+        {
+            IniFile::Keys& keyComments = replacement.first->keyComments;
+            for (auto comment = keyComments.begin(); comment != keyComments.end();)
+            {
+                if (replacement.first->keys.count(comment->first) == 0)
+                    comment = keyComments.erase(comment);
+                else
+                    ++comment;
+            }
+        }
+
+        notify = enqueueChanges(std::move(commitChanges));
+    }
+
+    if (notify)
+        publishChanges();
+}
+
+IniFile ConcurrentIniFile::snapshot() const
+{
+    vector<shared_lock<shared_mutex>> locks;
+    for (const auto& shard : shards)
+        locks.emplace_back(shard.mutex);
+
+    return snapshotLocked();
+}
+
+ChangeNotifier& ConcurrentIniFile::notifier()
+{
+    return changes;
+}
+
+IniFile ConcurrentIniFile::snapshotLocked() const
+{
+    IniFile ini;
+    {
+        lock_guard<mutex> lock(fileNameMutex);
+        ini.fileName = fileName;
+    }
+
+    for (const auto& shard : shards)
+    {
+        for (const auto& section : shard.sections)
+        {
+            shared_lock<shared_mutex> sectionLock(section.second->mutex);
+            ini.data.emplace(section.first, section.second->keys);
+            if (!section.second->keyComments.empty())
+                ini.keyComments.emplace(section.first, section.second->keyComments);
+            if (!section.second->comment.empty())
+                ini.sectionComments.emplace(section.first, section.second->comment);
+        }
+        for (const auto& comment : shard.pendingComments)
+            ini.sectionComments.emplace(comment.first, comment.second);
+    }
+
+    return ini;
+}
+
+ConcurrentIniFile::Shard& ConcurrentIniFile::shardFor(string_view lowerSection)
+{
+    return shards[hash<string_view>{}(lowerSection) % shardCount];
+}
+
+const ConcurrentIniFile::Shard& ConcurrentIniFile::shardFor(string_view lowerSection) const
+{
+    return shards[hash<string_view>{}(lowerSection) % shardCount];
+}
+
+void ConcurrentIniFile::adoptComment(Shard& shard, const string& lowerSection, Section& section) noexcept
+{
+    auto comment = shard.pendingComments.find(lowerSection);
+    if (comment == shard.pendingComments.end())
+        return;
+
+    section.comment.swap(comment->second);
+    shard.pendingComments.erase(comment);
+}
+
+bool ConcurrentIniFile::enqueueChanges(vector<IniChange> batch)
+{
+    if (batch.empty())
+        return false;
+
+    lock_guard<mutex> lock(pendingChangesMutex);
+    pendingChanges.push_back(std::move(batch));
+    return true;
+}
+
+void ConcurrentIniFile::publishChanges()
+{
+    unique_lock<mutex> lock(pendingChangesMutex);
+    if (publishing)
+        return;     // chi sta consegnando consegnera' anche questo batch, dopo quelli accodati prima
+
+    // le callback girano senza lock: una callback che modifica il file accoda e ritorna, senza deadlock
+    publishing = true;
+    while (!pendingChanges.empty())
+    {
+        vector<IniChange> batch = std::move(pendingChanges.front());
+        pendingChanges.pop_front();
+        lock.unlock();
+        try
+        {
+            changes.publish(batch);
+        }
+        catch (...)
+        {
+            lock.lock();
+            publishing = false;
+            throw;
+        }
+        lock.lock();
+    }
+    publishing = false;
+}
@@ -0,0 +1,76 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_CONCURRENTINIFILE_H
+#define INIMANAGER_CONCURRENTINIFILE_H
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include "IniFile.h"
+#include "ChangeNotifier.h"
+#include "IniTransaction.h"
+
+// Variante thread-safe di IniFile: le sezioni sono distribuite per hash su piu' shard. Il lock dello
+// shard e' strutturale (in esclusiva solo per aggiungere o rimuovere sezioni), mentre le chiavi
+// sono protette dal lock della singola sezione, quindi scritture su sezioni diverse non si bloccano.
+// Le notifiche vengono accodate mentre i lock sono ancora presi e consegnate da un solo thread alla
+// volta, quindi arrivano nell'ordine in cui le modifiche sono avvenute.
+class ConcurrentIniFile
+{
+    public:
+        ConcurrentIniFile() = default;
+        explicit ConcurrentIniFile(string name);
+        void load(const string& name);
+        void save(const string& name) const;
+        void save() const;
+        string get(const string& section, const string& key) const;
+        void set(const string& section, const string& key, const string& value);
+        void addSection(const string& section);
+        bool hasSection(const string& section) const;
+        bool hasKey(const string& section, const string& key) const;
+        vector<string> hasKey(const string& key) const;
+        bool deleteSection(const string& section);
+        bool deleteKey(const string& section, const string& key);
+        void commit(const IniTransaction& transaction);
+        IniFile snapshot() const;
+        ChangeNotifier& notifier();
+
+    private:
+        static constexpr size_t shardCount = 64;
+
+        struct Section
+        {
+            mutable shared_mutex mutex;
+            IniFile::Keys keys;
+            IniFile::Keys keyComments;
+            string comment;
+        };
+
+        struct alignas(64) Shard
+        {
+            mutable shared_mutex mutex;
+            map<string, unique_ptr<Section>> sections;
+            map<string, string> pendingComments;    // commenti di sezioni caricate senza chiavi, come in IniFile
+        };
+
+        string fileName;
+        mutable mutex fileNameMutex;
+        array<Shard, shardCount> shards;
+        ChangeNotifier changes;
+        mutex pendingChangesMutex;
+        deque<vector<IniChange>> pendingChanges;
+        bool publishing = false;
+
+        Shard& shardFor(string_view lowerSection);
+        const Shard& shardFor(string_view lowerSection) const;
+        static void adoptComment(Shard& shard, const string& lowerSection, Section& section) noexcept;
+        IniFile snapshotLocked() const;
+        bool enqueueChanges(vector<IniChange> batch);    // con i lock delle sezioni modificate ancora presi
+        void publishChanges();                          // dopo averli rilasciati
+};
+
+#endif //INIMANAGER_CONCURRENTINIFILE_H
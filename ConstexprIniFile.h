@@ -0,0 +1,227 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_CONSTEXPRINIFILE_H
+#define INIMANAGER_CONSTEXPRINIFILE_H
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include "IniFile.h"
+
+// Richiede i letterali come parametri template (C++20): con -DINIMANAGER_CXX20=ON il progetto compila in C++20.
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L && defined(__cpp_consteval)
+
+#define INIMANAGER_HAS_CONSTEXPR_INI 1
+
+// Letterale stringa utilizzabile come parametro template
+template <size_t N>
+struct IniLiteral
+{
+    char text[N];
+
+    constexpr IniLiteral(const char (&literal)[N])
+    {
+        for (size_t i = 0; i < N; i++)
+            text[i] = literal[i];
+    }
+
+    constexpr string_view view() const
+    {
+        return {text, N - 1};
+    }
+};
+
+struct ConstexprIniEntry
+{
+    string_view section;
+    string_view key;
+    string_view value;
+};
+
+namespace constexpr_ini
+{
+    constexpr char fold(char c)
+    {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    constexpr int compare(string_view a, string_view b)
+    {
+        for (size_t i = 0; i < a.size() && i < b.size(); i++)
+        {
+            char x = fold(a[i]), y = fold(b[i]);
+            if (x != y)
+                return static_cast<unsigned char>(x) < static_cast<unsigned char>(y) ? -1 : 1;
+        }
+        return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+    }
+
+    constexpr int compare(const ConstexprIniEntry& a, string_view section, string_view key)
+    {
+        int result = compare(a.section, section);
+        return result != 0 ? result : compare(a.key, key);
+    }
+
+    // Stesse regole di IniFile::load: righe vuote e commenti ignorati, CRLF accettato, nessun trim,
+    // le chiavi prima della prima sezione finiscono nella sezione "". Restituisce il numero di coppie.
+    template <typename Visitor>
+    constexpr size_t parse(string_view text, Visitor&& visit)
+    {
+        size_t count = 0;
+        string_view section;
+        while (!text.empty())
+        {
+            size_t end = text.find('\n');
+            string_view line = text.substr(0, end);
+            text.remove_prefix(end == string_view::npos ? text.size() : end + 1);
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty() || line[0] == ';')
+                continue;
+
+            if (line[0] == '[')
+            {
+                section = line.substr(1, line.size() - 2);
+                continue;
+            }
+
+            size_t pos = line.find('=');
+            if (pos == string_view::npos)
+                continue;
+
+            visit(ConstexprIniEntry{section, line.substr(0, pos), line.substr(pos + 1)});
+            count++;
+        }
+        return count;
+    }
+
+    // Ordina per sezione e chiave mantenendo, tra i duplicati, l'ultima occorrenza come fa IniFile::load
+    template <size_t Capacity>
+    constexpr size_t sortUnique(array<ConstexprIniEntry, Capacity>& entries)
+    {
+        // insertion sort stabile: le tabelle sono piccole e si ordina a tempo di compilazione
+        for (size_t i = 1; i < Capacity; i++)
+        {
+            ConstexprIniEntry entry = entries[i];
+            size_t j = i;
+            for (; j > 0 && compare(entries[j - 1], entry.section, entry.key) > 0; j--)
+                entries[j] = entries[j - 1];
+            entries[j] = entry;
+        }
+
+        size_t count = 0;
+        for (size_t i = 0; i < Capacity; i++)
+        {
+            if (i + 1 < Capacity && compare(entries[i + 1], entries[i].section, entries[i].key) == 0)
+                continue;
+            entries[count++] = entries[i];
+        }
+        return count;
+    }
+}
+
+// File INI analizzato interamente a tempo di compilazione:
+//
+//     using Defaults = ConstexprIniFile<"[network]\nport=8080\n">;
+//     constexpr string_view port = Defaults::at("network", "port");    // chiave inesistente: errore di compilazione
+//
+// La tabella e' ordinata, ha esattamente una voce per chiave e i suoi string_view puntano al letterale,
+// quindi non costa nulla a runtime. Sezioni e chiavi non distinguono maiuscole e minuscole, come in IniFile.
+template <IniLiteral Text>
+class ConstexprIniFile
+{
+    private:
+        static constexpr size_t capacity = constexpr_ini::parse(Text.view(), [](const ConstexprIniEntry&) {});
+
+        static constexpr auto sorted = []
+        {
+            array<ConstexprIniEntry, capacity> entries{};
+            size_t i = 0;
+            constexpr_ini::parse(Text.view(), [&entries, &i](const ConstexprIniEntry& entry) { entries[i++] = entry; });
+            size_t count = constexpr_ini::sortUnique(entries);
+            return pair(entries, count);
+        }();
+
+        static constexpr auto table = []
+        {
+            array<ConstexprIniEntry, sorted.second> entries{};
+            for (size_t i = 0; i < entries.size(); i++)
+                entries[i] = sorted.first[i];
+            return entries;
+        }();
+
+        static constexpr const ConstexprIniEntry* find(string_view section, string_view key)
+        {
+            size_t low = 0, high = table.size();
+            while (low < high)
+            {
+                size_t middle = low + (high - low) / 2;
+                int cmp = constexpr_ini::compare(table[middle], section, key);
+                if (cmp == 0)
+                    return &table[middle];
+                if (cmp < 0)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            return nullptr;
+        }
+
+    public:
+        static constexpr const array<ConstexprIniEntry, sorted.second>& entries()
+        {
+            return table;
+        }
+
+        static constexpr size_t size()
+        {
+            return table.size();
+        }
+
+        static constexpr string_view get(string_view section, string_view key)     // "" se la chiave non esiste
+        {
+            const ConstexprIniEntry* entry = find(section, key);
+            return entry != nullptr ? entry->value : string_view();
+        }
+
+        static consteval string_view at(string_view section, string_view key)
+        {
+            const ConstexprIniEntry* entry = find(section, key);
+            if (entry == nullptr)
+                throw logic_error("ConstexprIniFile: unknown section or key");    // non e' una costante: non compila
+            return entry->value;
+        }
+
+        static constexpr bool hasKey(string_view section, string_view key)
+        {
+            return find(section, key) != nullptr;
+        }
+
+        static constexpr bool hasSection(string_view section)
+        {
+            for (const auto& entry : table)
+            {
+                if (constexpr_ini::compare(entry.section, section) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        // Copia modificabile, ad esempio come base su cui caricare la configurazione dell'utente
+        static IniFile toIniFile()
+        {
+            IniFile ini;
+            for (const auto& entry : table)
+                ini.set(string(entry.section), string(entry.key), string(entry.value));
+            return ini;
+        }
+};
+
+#endif
+
+#endif //INIMANAGER_CONSTEXPRINIFILE_H
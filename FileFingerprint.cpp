@@ -0,0 +1,67 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "FileFingerprint.h"
+#include <fstream>
+#include <stdexcept>
+#include <sys/stat.h>
+
+FileFingerprint FileFingerprint::stat(const string& path)
+{
+    FileFingerprint fingerprint;
+
+    struct stat info{};
+    if (::stat(path.c_str(), &info) != 0)
+        return fingerprint;
+
+    fingerprint.exists = true;
+    fingerprint.size = static_cast<uint64_t>(info.st_size);
+#ifdef __APPLE__
+    fingerprint.mtime = int64_t(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    fingerprint.mtime = int64_t(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+    return fingerprint;
+}
+
+FileFingerprint FileFingerprint::of(const string& path)
+{
+    FileFingerprint fingerprint = stat(path);
+    if (fingerprint.exists)
+        fingerprint.hash = hashFile(path);
+
+    return fingerprint;
+}
+
+uint64_t FileFingerprint::hashFile(const string& path)
+{
+    ifstream file(path, ios::binary);
+    if (!file.is_open())
+        throw runtime_error("Unable to open file: " + path);
+
+    uint64_t hash = hashBytes(nullptr, 0);
+    char buffer[64 * 1024];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        hash = hashBytes(buffer, static_cast<size_t>(file.gcount()), hash);
+
+    return hash;
+}
+
+uint64_t FileFingerprint::hashBytes(const char* data, size_t length, uint64_t seed)
+{
+    // FNV-1a a 64 bit
+    uint64_t hash = seed;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+bool FileFingerprint::sameStat(const FileFingerprint& other) const
+{
+    return exists == other.exists && mtime == other.mtime && size == other.size;
+}
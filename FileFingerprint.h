@@ -0,0 +1,30 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_FILEFINGERPRINT_H
+#define INIMANAGER_FILEFINGERPRINT_H
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// Impronta di un file su disco: mtime e dimensione permettono un controllo immediato,
+// l'hash del contenuto serve solo quando questi due sono cambiati.
+struct FileFingerprint
+{
+    int64_t mtime = 0;      // nanosecondi
+    uint64_t size = 0;
+    uint64_t hash = 0;
+    bool exists = false;
+
+    static FileFingerprint stat(const string& path);
+    static FileFingerprint of(const string& path);
+    static uint64_t hashFile(const string& path);
+    static uint64_t hashBytes(const char* data, size_t length, uint64_t seed = 14695981039346656037ULL);
+
+    bool sameStat(const FileFingerprint& other) const;
+};
+
+#endif //INIMANAGER_FILEFINGERPRINT_H
@@ -0,0 +1,172 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniCorpus.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+static uint64_t splitMix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static const char valueAlphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 _-./:";
+
+IniCorpus::IniCorpus(IniCorpusOptions options) : options(options)
+{
+    if (this->options.maxValueSize < this->options.minValueSize)
+        this->options.maxValueSize = this->options.minValueSize;
+}
+
+uint64_t IniCorpus::write(ostream& out) const
+{
+    const char* newline = options.crlf ? "\r\n" : "\n";
+    uint64_t written = 0;
+
+    string buffer;
+    buffer.reserve(1 << 20);
+    auto flush = [&out, &buffer, &written]
+    {
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        written += buffer.size();
+        buffer.clear();
+    };
+
+    for (size_t s = 0; s < options.sections; s++)
+    {
+        if (chance(options.commentRatio, s, UINT64_MAX, 1))
+            buffer.append("; comment for section ").append(to_string(s)).append(newline);
+        buffer.append("[").append(sectionName(s)).append("]").append(newline);
+
+        for (size_t k = 0; k < options.keysPerSection; k++)
+        {
+            if (chance(options.commentRatio, s, k, 2))
+                buffer.append("; comment for key ").append(to_string(k)).append(newline);
+            buffer.append(keyName(s, k)).append("=").append(value(s, k)).append(newline);
+
+            if (buffer.size() >= (1 << 20))
+                flush();
+        }
+    }
+
+    flush();
+    if (!out)
+        throw runtime_error("Error writing INI corpus");
+
+    return written;
+}
+
+uint64_t IniCorpus::write(const string& fileName) const
+{
+    ofstream file(fileName, ios::binary);
+    if (!file.is_open())
+        throw runtime_error("Unable to open file for writing: " + fileName);
+
+    return write(file);
+}
+
+// somma delle cifre decimali degli indici 0..count-1
+static double totalDigits(uint64_t count)
+{
+    double total = 0;
+    for (uint64_t low = 0, high = 10, digits = 1; low < count; low = high, high *= 10, digits++)
+        total += static_cast<double>((min(count, high) - low) * digits);
+    return total;
+}
+
+uint64_t IniCorpus::estimatedSize() const
+{
+    double newline = options.crlf ? 2 : 1;
+    double valueLength = (options.minValueSize + options.maxValueSize) / 2.0;
+    valueLength += options.longLineRatio * (static_cast<double>(options.longLineSize) - valueLength);
+
+    double sectionDigits = totalDigits(options.sections);
+    double keyDigits = totalDigits(options.keysPerSection);
+    double sections = options.sections;
+    double keys = sections * options.keysPerSection;
+
+    double size = sections * (9 + newline) + sectionDigits;                     // [sectionN]
+    size += options.commentRatio * (sections * (22 + newline) + sectionDigits);
+    size += keys * (4 + valueLength + newline) + sections * keyDigits;          // keyN=value
+    size += options.commentRatio * (keys * (18 + newline) + sections * keyDigits);
+    return static_cast<uint64_t>(size);
+}
+
+string IniCorpus::sectionName(size_t section) const
+{
+    return varyCase("section" + to_string(section), section, UINT64_MAX);
+}
+
+string IniCorpus::keyName(size_t section, size_t key) const
+{
+    return varyCase("key" + to_string(key), section, key);
+}
+
+string IniCorpus::value(size_t section, size_t key) const
+{
+    size_t length = options.minValueSize;
+    if (chance(options.longLineRatio, section, key, 3))
+        length = options.longLineSize;
+    else if (options.maxValueSize > options.minValueSize)
+        length += random(section, key, 4) % (options.maxValueSize - options.minValueSize + 1);
+
+    string result(length, ' ');
+    uint64_t bits = random(section, key, 5);
+    for (size_t i = 0; i < length; i++)
+    {
+        if (i % 8 == 0 && i > 0)
+            bits = splitMix64(bits);
+        result[i] = valueAlphabet[((bits >> (i % 8 * 8)) & 0xff) % (sizeof(valueAlphabet) - 1)];
+    }
+
+    // niente spazi agli estremi, cosi' il valore sopravvive a qualsiasi editor; con minValueSize 0 puo' essere vuoto
+    if (!result.empty() && result.front() == ' ')
+        result.front() = 'x';
+    if (!result.empty() && result.back() == ' ')
+        result.back() = 'x';
+    return result;
+}
+
+IniCorpusOptions IniCorpus::forTargetSize(uint64_t bytes, IniCorpusOptions options)
+{
+    options.sections = 1;
+    uint64_t perSection = max<uint64_t>(1, IniCorpus(options).estimatedSize());
+    options.sections = static_cast<size_t>(max<uint64_t>(1, bytes / perSection));
+    return options;
+}
+
+uint64_t IniCorpus::random(uint64_t a, uint64_t b, uint64_t salt) const
+{
+    // ogni valore dipende solo dalla propria posizione, non dall'ordine di generazione
+    return splitMix64(splitMix64(splitMix64(options.seed ^ salt) ^ a) ^ b);
+}
+
+bool IniCorpus::chance(double ratio, uint64_t a, uint64_t b, uint64_t salt) const
+{
+    if (ratio <= 0)
+        return false;
+    if (ratio >= 1)
+        return true;
+
+    return static_cast<double>(random(a, b, salt) >> 11) * 0x1.0p-53 < ratio;
+}
+
+string IniCorpus::varyCase(string name, uint64_t a, uint64_t b) const
+{
+    if (!options.caseVariation)
+        return name;
+
+    uint64_t bits = random(a, b, 6);
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        if ((bits >> (i % 64)) & 1)
+            name[i] = static_cast<char>(toupper(static_cast<unsigned char>(name[i])));
+    }
+
+    return name;
+}
@@ -0,0 +1,54 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INICORPUS_H
+#define INIMANAGER_INICORPUS_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+struct IniCorpusOptions
+{
+    uint64_t seed = 1;
+    size_t sections = 10;
+    size_t keysPerSection = 10;
+    size_t minValueSize = 1;
+    size_t maxValueSize = 32;
+    double commentRatio = 0.0;      // probabilita' che sezione o chiave abbiano un commento
+    bool crlf = false;
+    double longLineRatio = 0.0;     // probabilita' che un valore sia lungo longLineSize
+    size_t longLineSize = 4096;
+    bool caseVariation = false;     // maiuscole/minuscole casuali nei nomi
+};
+
+// Generatore deterministico di file INI sintetici: a parita' di opzioni (seed compreso) produce
+// sempre gli stessi byte. Ogni valore dipende solo da seed, sezione e chiave, quindi puo' essere
+// ricalcolato per verificare un file caricato senza tenerlo in memoria.
+class IniCorpus
+{
+    public:
+        explicit IniCorpus(IniCorpusOptions options);
+
+        uint64_t write(ostream& out) const;
+        uint64_t write(const string& fileName) const;
+        uint64_t estimatedSize() const;
+
+        string sectionName(size_t section) const;
+        string keyName(size_t section, size_t key) const;
+        string value(size_t section, size_t key) const;
+
+        static IniCorpusOptions forTargetSize(uint64_t bytes, IniCorpusOptions options = {});
+
+    private:
+        IniCorpusOptions options;
+
+        uint64_t random(uint64_t a, uint64_t b, uint64_t salt) const;
+        bool chance(double ratio, uint64_t a, uint64_t b, uint64_t salt) const;
+        string varyCase(string name, uint64_t a, uint64_t b) const;
+};
+
+#endif //INIMANAGER_INICORPUS_H
@@ -0,0 +1,162 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniDirectoryLoader.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <thread>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+IniDirectoryLoader::IniDirectoryLoader(unsigned threads)
+    : threads(threads > 0 ? threads : max(1u, thread::hardware_concurrency()))
+{
+}
+
+vector<string> IniDirectoryLoader::list(const string& directory, const string& pattern)
+{
+    error_code error;
+    filesystem::directory_iterator it(directory, error);
+    if (error)
+        throw runtime_error("Unable to open directory: " + directory);
+
+    vector<string> files;
+    for (const auto& entry : it)
+    {
+        string name = entry.path().filename().string();
+        if (entry.is_regular_file(error) && fnmatch(pattern.c_str(), name.c_str(), FNM_PERIOD) == 0)
+            files.push_back(entry.path().string());
+    }
+
+    sort(files.begin(), files.end());   // ordine lessicografico, indipendente dal filesystem
+    return files;
+}
+
+IniFile IniDirectoryLoader::load(const string& directory, const string& pattern, vector<IniFragmentTiming>* timings) const
+{
+    vector<string> files = list(directory, pattern);
+
+    // chiede al kernel di leggere in anticipo tutti i file: mentre i thread analizzano i primi,
+    // i successivi arrivano in page cache
+    vector<uint64_t> sizes(files.size(), 0);
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        int fd = open(files[i].c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            continue;   // l'errore emergera' dal caricamento vero e proprio
+
+        struct stat info;
+        if (fstat(fd, &info) == 0)
+            sizes[i] = static_cast<uint64_t>(info.st_size);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        close(fd);
+    }
+
+    vector<IniFile> fragments(files.size());
+    vector<chrono::nanoseconds> loadTimes(files.size());
+    vector<exception_ptr> errors(files.size());
+    atomic<size_t> next{0};
+
+    auto worker = [&]
+    {
+        for (size_t i = next++; i < files.size(); i = next++)
+        {
+            auto start = chrono::steady_clock::now();
+            try
+            {
+                fragments[i].load(files[i]);
+            }
+            catch (...)
+            {
+                errors[i] = current_exception();
+            }
+            loadTimes[i] = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+        }
+    };
+
+    // i thread usano variabili di questo frame: si aspettano su ogni percorso, cosi' se la creazione di uno
+    // fallisce (system_error, es. limite di thread del container) l'errore arriva come eccezione, non come terminate
+    struct JoinAll
+    {
+        vector<thread>& pool;
+        atomic<size_t>& next;
+        size_t end;
+
+        ~JoinAll()
+        {
+            next = end;     // sui percorsi d'errore nessun file nuovo: chi sta lavorando finisce il suo
+            for (auto& t : pool)
+            {
+                if (t.joinable())
+                    t.join();
+            }
+        }
+    };
+
+    vector<thread> pool;
+    size_t workers = min<size_t>(threads, files.size());
+    pool.reserve(workers);
+    {
+        JoinAll joinAll{pool, next, files.size()};
+        for (size_t t = 1; t < workers; t++)
+            pool.emplace_back(worker);
+        worker();   // anche il thread chiamante partecipa
+    }
+
+    for (const auto& error : errors)
+    {
+        if (error)
+            rethrow_exception(error);   // il primo file in ordine che non si e' potuto caricare
+    }
+
+    IniFile result;
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        merge(result, std::move(fragments[i]));
+        if (timings != nullptr)
+            timings->push_back({files[i], sizes[i], loadTimes[i]});
+    }
+
+    return result;
+}
+
+void IniDirectoryLoader::merge(IniFile& target, IniFile&& fragment)
+{
+    target.materializeComments();
+    fragment.materializeComments();
+    if (target.data.empty() && target.sectionComments.empty() && target.keyComments.empty())
+    {
+        target.data = std::move(fragment.data);
+        target.sectionComments = std::move(fragment.sectionComments);
+        target.keyComments = std::move(fragment.keyComments);
+        return;
+    }
+
+    // l'ultimo file vince: le chiavi del frammento sovrascrivono quelle gia' presenti
+    for (auto& section : fragment.data)
+    {
+        auto& keys = target.data[section.first];
+        if (keys.empty())
+        {
+            keys = std::move(section.second);
+            continue;
+        }
+        auto& targetKeys = keys.edit();
+        for (auto& key : section.second.take())
+            targetKeys.insert_or_assign(key.first, std::move(key.second));
+    }
+
+    for (auto& comment : fragment.sectionComments)
+        target.sectionComments.insert_or_assign(comment.first, std::move(comment.second));
+    for (auto& section : fragment.keyComments)
+    {
+        auto& targetComments = target.keyComments[section.first].edit();
+        for (auto& comment : section.second.take())
+            targetComments.insert_or_assign(comment.first, std::move(comment.second));
+    }
+}
@@ -0,0 +1,39 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INIDIRECTORYLOADER_H
+#define INIMANAGER_INIDIRECTORYLOADER_H
+
+#include <chrono>
+#include "IniFile.h"
+
+using namespace std;
+
+struct IniFragmentTiming
+{
+    string fileName;
+    uint64_t bytes;
+    chrono::nanoseconds loadTime;   // apertura e parsing del singolo file, sul thread che lo ha caricato
+};
+
+// Carica tutti i file di una directory che corrispondono a un pattern glob (stile conf.d) e li unisce
+// in un unico IniFile. I file vengono letti e analizzati in parallelo, ma l'unione segue l'ordine
+// lessicografico dei nomi: a parita' di chiave vince il file che viene dopo.
+class IniDirectoryLoader
+{
+    public:
+        explicit IniDirectoryLoader(unsigned threads = 0);     // 0: un thread per core
+
+        IniFile load(const string& directory, const string& pattern = "*.ini",
+                     vector<IniFragmentTiming>* timings = nullptr) const;
+
+        static vector<string> list(const string& directory, const string& pattern = "*.ini");
+
+    private:
+        unsigned threads;
+
+        static void merge(IniFile& target, IniFile&& fragment);
+};
+
+#endif //INIMANAGER_INIDIRECTORYLOADER_H
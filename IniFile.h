@@ -5,44 +5,17 @@
 #ifndef INIMANAGER_INIFILE_H
 #define INIMANAGER_INIFILE_H
 
-#include <string>
-#include <map>
-#include <fstream>
-#include <algorithm>
-#include <stdexcept>
-#include <iostream>
-#include <vector>
+#include "BasicIniFile.h"
 
 using namespace std;
 
-class IniFile
-{
-    public:
-        IniFile() = default;
-        explicit IniFile(string name);
-        void load(const string& name);
-        void save(const string& name) const;
-        void save() const;
-        string get(const string& section, const string& key) const;
-        void set(const string& section, const string& key, const string& value);
-        void addSection(const string& section);
-        bool hasSection(const string& section) const;
-        bool hasKey(const string& section, const string& key) const;
-        vector<string> hasKey(const string& key) const;
-        bool deleteSection(const string& section);
-        bool deleteKey(const string& section, const string& key);
-        bool setSectionComment(const string& section, const string& comment);
-        bool setKeyComment(const string& section, const string& key, const string& comment);
-        string getSectionComment(const string& section) const;
-        string getKeyComment(const string& section, const string& key) const;
-        string print(bool print_comments) const;
+// nomi senza distinzione tra maiuscole e minuscole, commenti conservati, mappe ordinate in una risorsa pmr
+using IniFile = BasicIniFile<>;
 
-    private:
-        string fileName;
-        map<string, map<string, string>> data;
-        map<string, string> sectionComments;
-        map<string, map<string, string>> keyComments;
-        static string toLower(const string &str);
-};
+extern template class BasicIniFile<>;       // istanziata una volta sola, in IniFile.cpp
+
+// stesse funzionalita' di IniFile con IniAdaptiveStorage: vettore ordinato per le sezioni piccole, indice hash
+// per quelle grandi; save() e print() restano in ordine alfabetico
+using AdaptiveIniFile = BasicIniFile<IniCaseInsensitive, IniKeepComments, IniAdaptiveStorage<>>;
 
 #endif //INIMANAGER_INIFILE_H
@@ -0,0 +1,248 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniFileWatcher.h"
+#include <filesystem>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+IniFileWatcher::IniFileWatcher(string name, chrono::milliseconds debounce) : fileName(std::move(name)), debounce(debounce)
+{
+#ifdef __linux__
+    startInotify();     // prima del caricamento, cosi' nessuna modifica successiva va persa
+#endif
+
+    // l'impronta precede il caricamento: se il file cambia mentre lo si legge, l'evento inotify in arrivo
+    // trova un'impronta diversa e ricarica, invece di scambiare il nuovo contenuto per quello gia' letto
+    auto loaded = make_shared<IniFile>();
+    try
+    {
+        fingerprint = FileFingerprint::of(fileName);
+        loaded->load(fileName);
+    }
+    catch (...)
+    {
+#ifdef __linux__
+        if (inotifyFd >= 0)
+            close(inotifyFd);
+        if (stopFd >= 0)
+            close(stopFd);
+#endif
+        throw;
+    }
+    config = loaded;
+
+    worker = thread(&IniFileWatcher::watch, this);
+}
+
+IniFileWatcher::~IniFileWatcher()
+{
+    stop();
+#ifdef __linux__
+    if (inotifyFd >= 0)
+        close(inotifyFd);
+    if (stopFd >= 0)
+        close(stopFd);
+#endif
+}
+
+shared_ptr<const IniFile> IniFileWatcher::current() const
+{
+    return atomic_load(&config);
+}
+
+void IniFileWatcher::onReload(ReloadCallback newCallback)
+{
+    lock_guard<mutex> lock(reloadMutex);
+    callback = std::move(newCallback);
+}
+
+bool IniFileWatcher::reloadIfChanged()
+{
+    shared_ptr<const IniFile> previous;
+    shared_ptr<const IniFile> loaded;
+    {
+        lock_guard<mutex> lock(reloadMutex);
+
+        FileFingerprint changed = FileFingerprint::stat(fileName);
+        if (!changed.exists || changed.sameStat(fingerprint))
+            return false;
+
+        auto parsed = make_shared<IniFile>();
+        try
+        {
+            // se il contenuto e' identico (es. touch o riscrittura uguale) il parsing viene saltato
+            changed.hash = FileFingerprint::hashFile(fileName);
+            if (changed.size == fingerprint.size && changed.hash == fingerprint.hash)
+            {
+                fingerprint = changed;
+                return false;
+            }
+
+            parsed->load(fileName);
+        }
+        catch (const exception& e)
+        {
+            cerr << "Error reloading INI file: " << e.what() << endl;
+            return false;
+        }
+
+        fingerprint = changed;
+        loaded = parsed;
+        previous = atomic_exchange(&config, loaded);
+        reloads.fetch_add(1, memory_order_relaxed);
+
+        if (callback)
+            callback(previous, loaded);
+    }
+
+    // il diff e le notifiche avvengono fuori dal lock del reload
+    if (!changes.empty())
+        changes.publish(IniFile::diff(*previous, *loaded));
+
+    return true;
+}
+
+uint64_t IniFileWatcher::reloadCount() const
+{
+    return reloads.load(memory_order_relaxed);
+}
+
+ChangeNotifier& IniFileWatcher::notifier()
+{
+    return changes;
+}
+
+void IniFileWatcher::stop()
+{
+    if (stopping.exchange(true))
+        return;
+
+    {
+        lock_guard<mutex> lock(stopMutex);
+        stopCondition.notify_all();
+    }
+#ifdef __linux__
+    if (stopFd >= 0)
+    {
+        uint64_t one = 1;
+        if (write(stopFd, &one, sizeof(one)) < 0)
+            cerr << "Error stopping INI file watcher" << endl;
+    }
+#endif
+
+    if (worker.joinable())
+        worker.join();
+}
+
+void IniFileWatcher::watch()
+{
+#ifdef __linux__
+    if (inotifyFd >= 0)
+    {
+        inotifyLoop();
+        return;
+    }
+#endif
+    pollLoop();
+}
+
+void IniFileWatcher::pollLoop()
+{
+    unique_lock<mutex> lock(stopMutex);
+    while (!stopping)
+    {
+        stopCondition.wait_for(lock, debounce);
+        if (stopping)
+            break;
+
+        lock.unlock();
+        reloadIfChanged();
+        lock.lock();
+    }
+}
+
+#ifdef __linux__
+void IniFileWatcher::startInotify()
+{
+    stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (stopFd < 0)
+        return;
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0)
+        return;
+
+    // si osserva la directory, perche' molti editor salvano su un file temporaneo e poi lo rinominano
+    filesystem::path path(fileName);
+    string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+
+    if (inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE) < 0)
+    {
+        close(inotifyFd);
+        inotifyFd = -1;     // si ripiega sul polling
+    }
+}
+
+void IniFileWatcher::inotifyLoop()
+{
+    int fd = inotifyFd;
+    string baseName = filesystem::path(fileName).filename().string();
+
+    pollfd fds[2] = {{fd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+    bool pending = false;
+    chrono::steady_clock::time_point deadline;
+
+    while (!stopping)
+    {
+        int timeout = -1;
+        if (pending)
+        {
+            auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+            timeout = static_cast<int>(max<chrono::milliseconds::rep>(0, remaining.count()));
+        }
+
+        int ready = poll(fds, 2, timeout);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[1].revents != 0)
+            break;
+
+        if (ready == 0)
+        {
+            pending = false;
+            reloadIfChanged();
+            continue;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* p = buffer; p < buffer + length;)
+            {
+                auto* event = reinterpret_cast<inotify_event*>(p);
+                if (event->len > 0 && baseName == event->name)
+                {
+                    // ogni nuovo evento sposta in avanti la scadenza (debounce)
+                    pending = true;
+                    deadline = chrono::steady_clock::now() + debounce;
+                }
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+    }
+}
+#endif
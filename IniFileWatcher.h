@@ -0,0 +1,64 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INIFILEWATCHER_H
+#define INIMANAGER_INIFILEWATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "IniFile.h"
+#include "FileFingerprint.h"
+#include "ChangeNotifier.h"
+
+// Tiene sotto controllo un file INI e lo ricarica in un thread in background quando viene
+// scritto o sostituito (inotify su Linux, polling altrove). I lettori ottengono sempre una
+// versione completa tramite current(), che viene sostituita atomicamente.
+class IniFileWatcher
+{
+    public:
+        using ReloadCallback = function<void(const shared_ptr<const IniFile>& previous, const shared_ptr<const IniFile>& current)>;
+
+        explicit IniFileWatcher(string name, chrono::milliseconds debounce = chrono::milliseconds(100));
+        ~IniFileWatcher();
+        IniFileWatcher(const IniFileWatcher&) = delete;
+        IniFileWatcher& operator=(const IniFileWatcher&) = delete;
+
+        shared_ptr<const IniFile> current() const;
+        void onReload(ReloadCallback callback);
+        bool reloadIfChanged();
+        uint64_t reloadCount() const;
+        ChangeNotifier& notifier();
+        void stop();
+
+    private:
+        string fileName;
+        chrono::milliseconds debounce;
+        shared_ptr<const IniFile> config;
+        FileFingerprint fingerprint;
+        atomic<uint64_t> reloads{0};
+        mutex reloadMutex;          // serializza i reload e protegge fingerprint e callback
+        ReloadCallback callback;
+        ChangeNotifier changes;
+
+        thread worker;
+        atomic<bool> stopping{false};
+        mutex stopMutex;
+        condition_variable stopCondition;
+        int stopFd = -1;
+        int inotifyFd = -1;
+
+        void watch();
+        void pollLoop();
+#ifdef __linux__
+        void startInotify();
+        void inotifyLoop();
+#endif
+};
+
+#endif //INIMANAGER_INIFILEWATCHER_H
@@ -0,0 +1,203 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniInterpolator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+IniInterpolator& IniInterpolator::operator=(const IniInterpolator&)
+{
+    clear();    // i dati dell'IniFile sono stati sostituiti
+    return *this;
+}
+
+string IniInterpolator::resolve(const string& section, const string& key, Fold fold, const Lookup& lookup)
+{
+    KeyId id(section, key);
+    fold(id.first);
+    fold(id.second);
+
+    lock_guard<mutex> lock(cacheMutex);
+    vector<KeyId> stack;
+    return resolveLocked(id, fold, lookup, stack);
+}
+
+const string& IniInterpolator::resolveLocked(const KeyId& id, Fold fold, const Lookup& lookup, vector<KeyId>& stack)
+{
+    auto cached = cache.find(id);
+    if (cached != cache.end())
+    {
+        if (cached->second.error)
+            throw runtime_error(cached->second.value);
+        return cached->second.value;
+    }
+
+    auto cycleStart = find(stack.begin(), stack.end(), id);
+    if (cycleStart != stack.end())
+    {
+        string message = "Interpolation cycle:";
+        for (auto it = cycleStart; it != stack.end(); ++it)
+            message += " " + it->first + ":" + it->second + " ->";
+        message += " " + id.first + ":" + id.second;
+
+        // ogni chiave della pila lo memorizza mentre l'errore risale (vedi sotto)
+        throw runtime_error(message);
+    }
+
+    string raw(lookup(id.first, id.second));
+
+    stack.push_back(id);
+    string value;
+    for (size_t pos = 0; pos < raw.size();)
+    {
+        size_t dollar = raw.find('$', pos);
+        if (dollar == string::npos || dollar + 1 == raw.size())
+        {
+            value.append(raw, pos, string::npos);
+            break;
+        }
+
+        value.append(raw, pos, dollar - pos);
+        if (raw[dollar + 1] == '$')
+        {
+            value += '$';
+            pos = dollar + 2;
+            continue;
+        }
+
+        size_t close = raw[dollar + 1] == '{' ? raw.find('}', dollar + 2) : string::npos;
+        if (close == string::npos)  // non e' un riferimento: il '$' resta com'e'
+        {
+            value += '$';
+            pos = dollar + 1;
+            continue;
+        }
+
+        string reference = raw.substr(dollar + 2, close - dollar - 2);
+        pos = close + 1;
+
+        size_t colon = reference.find(':');
+        if (colon != string::npos && reference.compare(0, colon, "ENV") == 0)
+        {
+            const char* env = getenv(reference.c_str() + colon + 1);
+            if (env != nullptr)
+                value += env;
+            continue;
+        }
+
+        KeyId target = colon == string::npos
+                       ? KeyId(id.first, reference)
+                       : KeyId(reference.substr(0, colon), reference.substr(colon + 1));
+        if (colon != string::npos)
+            fold(target.first);
+        fold(target.second);
+
+        // la dipendenza viene registrata prima della ricorsione, cosi' anche gli errori si invalidano;
+        // i set la tengono una volta sola anche se il riferimento si ripete
+        dependents[target].insert(id);
+        used[id].insert(target);
+        try
+        {
+            value += resolveLocked(target, fold, lookup, stack);
+        }
+        catch (const runtime_error& error)
+        {
+            // anche chi usa un ciclo resta in errore, senza rifare la visita a ogni richiesta
+            stack.pop_back();
+            cache[id] = {error.what(), true};
+            populated = true;
+            throw;
+        }
+    }
+    stack.pop_back();
+
+    populated = true;
+    return cache[id].value = std::move(value);
+}
+
+void IniInterpolator::invalidate(string_view section, string_view key)
+{
+    if (!populated)
+        return;
+
+    lock_guard<mutex> lock(cacheMutex);
+    invalidateLocked({{string(section), string(key)}});
+}
+
+void IniInterpolator::invalidateSection(string_view name)
+{
+    if (!populated)
+        return;
+
+    lock_guard<mutex> lock(cacheMutex);
+    string section(name);
+    vector<KeyId> pending;
+    for (auto it = cache.lower_bound({section, ""}); it != cache.end() && it->first.first == section; ++it)
+        pending.push_back(it->first);
+    for (auto it = dependents.lower_bound({section, ""}); it != dependents.end() && it->first.first == section; ++it)
+        pending.push_back(it->first);
+    invalidateLocked(std::move(pending));
+}
+
+void IniInterpolator::invalidateLocked(vector<KeyId> pending)
+{
+    while (!pending.empty())
+    {
+        KeyId id = std::move(pending.back());
+        pending.pop_back();
+
+        cache.erase(id);
+
+        auto users = dependents.find(id);
+        if (users != dependents.end())
+        {
+            pending.insert(pending.end(), users->second.begin(), users->second.end());
+            dependents.erase(users);
+        }
+
+        // il valore verra' ricalcolato: i suoi archi uscenti non valgono piu'
+        auto targets = used.find(id);
+        if (targets != used.end())
+        {
+            for (const auto& target : targets->second)
+            {
+                auto targetUsers = dependents.find(target);
+                if (targetUsers != dependents.end())
+                {
+                    targetUsers->second.erase(id);
+                    if (targetUsers->second.empty())
+                        dependents.erase(targetUsers);
+                }
+            }
+            used.erase(targets);
+        }
+    }
+
+    populated = !cache.empty() || !dependents.empty();
+}
+
+void IniInterpolator::clear()
+{
+    lock_guard<mutex> lock(cacheMutex);
+    cache.clear();
+    used.clear();
+    dependents.clear();
+    populated = false;
+}
+
+size_t IniInterpolator::size() const
+{
+    lock_guard<mutex> lock(cacheMutex);
+    return cache.size();
+}
+
+size_t IniInterpolator::references() const
+{
+    lock_guard<mutex> lock(cacheMutex);
+    size_t count = 0;
+    for (const auto& targets : used)
+        count += targets.second.size();
+    return count;
+}
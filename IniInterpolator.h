@@ -0,0 +1,60 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INIINTERPOLATOR_H
+#define INIMANAGER_INIINTERPOLATOR_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Risoluzione dei riferimenti ${section:key}, ${key} (stessa sezione) e ${ENV:VAR}; $$ produce un '$'.
+// I valori risolti vengono memorizzati insieme a un grafo delle dipendenze: quando una chiave cambia
+// vengono invalidati solo i valori che la usano, direttamente o indirettamente. Un ciclo viene scoperto
+// alla prima risoluzione e memorizzato come errore per tutte le chiavi che lo attraversano, cicliche o no.
+// Le variabili d'ambiente sono lette una volta sola.
+class IniInterpolator
+{
+    public:
+        IniInterpolator() = default;
+        IniInterpolator(const IniInterpolator&) {}      // la cache appartiene ai dati di un solo IniFile
+        IniInterpolator& operator=(const IniInterpolator&);
+
+        using Fold = void (*)(string& name);    // normalizza un nome come nelle mappe del file
+        using Lookup = function<string_view(const string& section, const string& key)>;    // valore grezzo, nomi gia' normalizzati
+
+        string resolve(const string& section, const string& key, Fold fold, const Lookup& lookup);
+        void invalidate(string_view section, string_view key);
+        void invalidateSection(string_view section);
+        void clear();
+        size_t size() const;
+        size_t references() const;      // archi del grafo delle dipendenze
+
+    private:
+        using KeyId = pair<string, string>;     // sezione e chiave normalizzate
+
+        struct Entry
+        {
+            string value;
+            bool error = false;     // value contiene il messaggio d'errore
+        };
+
+        mutable mutex cacheMutex;
+        atomic<bool> populated{false};  // evita il lock nelle modifiche quando non c'e' nulla in cache
+        map<KeyId, Entry> cache;
+        map<KeyId, set<KeyId>> used;            // chiavi usate da ogni valore risolto
+        map<KeyId, set<KeyId>> dependents;      // valori risolti che usano ogni chiave
+
+        const string& resolveLocked(const KeyId& id, Fold fold, const Lookup& lookup, vector<KeyId>& stack);
+        void invalidateLocked(vector<KeyId> pending);
+};
+
+#endif //INIMANAGER_INIINTERPOLATOR_H
@@ -0,0 +1,116 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniLazyComments.h"
+
+IniLazyComments::IniLazyComments(const IniLazyComments& other)
+{
+    lock_guard<mutex> lock(other.materializeMutex);
+    source = other.source;
+    entries = other.entries;
+    hasPending = !entries.empty();
+}
+
+IniLazyComments& IniLazyComments::operator=(const IniLazyComments& other)
+{
+    if (this == &other)
+        return *this;
+
+    scoped_lock lock(materializeMutex, other.materializeMutex);
+    source = other.source;
+    entries = other.entries;
+    hasPending = !entries.empty();
+    return *this;
+}
+
+IniLazyComments::Range IniLazyComments::range(const string& buffer, string_view view)
+{
+    return {view.empty() ? 0 : static_cast<size_t>(view.data() - buffer.data()), view.size()};
+}
+
+void IniLazyComments::add(const string& buffer, string_view section, string_view key, string_view comment)
+{
+    entries.push_back({range(buffer, section), range(buffer, key), range(buffer, comment)});
+}
+
+void IniLazyComments::addSection(const string& buffer, string_view section, string_view comment)
+{
+    entries.push_back({range(buffer, section), {0, string::npos}, range(buffer, comment)});
+}
+
+void IniLazyComments::retain(string buffer)
+{
+    // gli intervalli sono offset, quindi restano validi anche se lo spostamento cambia l'indirizzo dei dati
+    if (entries.empty())
+        return;
+
+    source = make_shared<const string>(std::move(buffer));
+    hasPending = true;
+}
+
+bool IniLazyComments::pending() const
+{
+    return hasPending.load(memory_order_acquire);
+}
+
+size_t IniLazyComments::size() const
+{
+    lock_guard<mutex> lock(materializeMutex);
+    return entries.size();
+}
+
+size_t IniLazyComments::memoryUsage() const
+{
+    lock_guard<mutex> lock(materializeMutex);
+    size_t bytes = entries.capacity() * sizeof(Entry);
+    if (source)
+        bytes += source->capacity() + 1;
+    return bytes;
+}
+
+string_view IniLazyComments::text(Range range) const
+{
+    return string_view(source->data() + range.offset, range.length);
+}
+
+void IniLazyComments::materialize(const function<void(string_view section, const string_view* key, string_view comment)>& insert)
+{
+    lock_guard<mutex> lock(materializeMutex);
+    if (!hasPending)
+        return;
+
+    for (const auto& entry : entries)
+    {
+        // l'intervallo copre righe consecutive: si tolgono le righe vuote e i '\r', come fa load
+        string comment;
+        comment.reserve(entry.comment.length + 1);
+        string_view block = text(entry.comment);
+        while (!block.empty())
+        {
+            size_t end = block.find('\n');
+            string_view line = block.substr(0, end);
+            block.remove_prefix(end == string_view::npos ? block.size() : end + 1);
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (!line.empty())
+                comment.append(line).append(1, '\n');
+        }
+
+        // stesso ordine del file: a parita' di nome vince l'ultimo commento, come con CommentMode::Keep
+        string_view section = text(entry.section);
+        if (entry.key.length == string::npos)
+            insert(section, nullptr, comment);
+        else
+        {
+            string_view key = text(entry.key);
+            insert(section, &key, comment);
+        }
+    }
+
+    entries.clear();
+    entries.shrink_to_fit();
+    source.reset();
+    hasPending.store(false, memory_order_release);
+}
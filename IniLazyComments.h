@@ -0,0 +1,63 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INILAZYCOMMENTS_H
+#define INIMANAGER_INILAZYCOMMENTS_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Commenti caricati con IniCommentMode::Lazy: il buffer del file viene trattenuto e per ogni blocco
+// di commenti si registrano soltanto gli intervalli di byte del commento e dei nomi di sezione e chiave.
+// Le stringhe vengono create tutte insieme al primo accesso ai commenti, poi il buffer viene rilasciato.
+class IniLazyComments
+{
+    public:
+        IniLazyComments() = default;
+        IniLazyComments(const IniLazyComments& other);
+        IniLazyComments& operator=(const IniLazyComments& other);
+
+        // i string_view devono puntare in buffer, che viene poi consegnato con retain()
+        void add(const string& buffer, string_view section, string_view key, string_view comment);
+        void addSection(const string& buffer, string_view section, string_view comment);
+        void retain(string buffer);
+
+        bool pending() const;
+        size_t size() const;
+        size_t memoryUsage() const;     // buffer trattenuto (anche se condiviso con le copie) e indice
+        // insert riceve i nomi come sono scritti nel file (li normalizza chi li inserisce);
+        // key e' nullptr per il commento di una sezione
+        void materialize(const function<void(string_view section, const string_view* key, string_view comment)>& insert);
+
+    private:
+        struct Range
+        {
+            size_t offset;
+            size_t length;
+        };
+
+        struct Entry
+        {
+            Range section;
+            Range key;      // length == npos per il commento di una sezione
+            Range comment;
+        };
+
+        mutable mutex materializeMutex;
+        atomic<bool> hasPending{false};     // evita il lock quando non resta nulla da materializzare
+        shared_ptr<const string> source;    // condiviso tra le copie, non viene mai modificato
+        vector<Entry> entries;
+
+        static Range range(const string& buffer, string_view view);
+        string_view text(Range range) const;
+};
+
+#endif //INIMANAGER_INILAZYCOMMENTS_H
@@ -0,0 +1,69 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INIMEMORYUSAGE_H
+#define INIMANAGER_INIMEMORYUSAGE_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+using namespace std;
+
+// Memoria occupata da un IniFile (o da una sua sezione), stimata da dimensioni e capacita' dei contenitori
+// senza interrogare l'allocatore: non comprende l'intestazione di malloc ne' lo spreco di una memory_resource.
+struct IniMemoryFootprint
+{
+    size_t data = 0;        // caratteri di nomi di sezione, chiavi e valori
+    size_t comments = 0;    // caratteri dei commenti e dei nomi usati solo per indicizzarli
+    size_t nodes = 0;       // nodi dei contenitori: puntatori, oggetti stringa, bucket
+    size_t slack = 0;       // capacita' allocata e non usata, terminatori compresi
+
+    size_t total() const
+    {
+        return data + comments + nodes + slack;
+    }
+
+    IniMemoryFootprint& operator+=(const IniMemoryFootprint& other)
+    {
+        data += other.data;
+        comments += other.comments;
+        nodes += other.nodes;
+        slack += other.slack;
+        return *this;
+    }
+
+    // un nodo di nodeBytes byte che contiene le stringhe indicate; i loro caratteri vanno in payload
+    // (data o comments). Le stringhe corte stanno nel nodo stesso (SSO): quei byte si tolgono da nodes.
+    template <typename... Strings>
+    void addNode(size_t nodeBytes, size_t& payload, const Strings&... strings)
+    {
+        nodes += nodeBytes;
+        (addString(payload, strings), ...);
+    }
+
+    template <typename String>
+    void addString(size_t& payload, const String& str)
+    {
+        payload += str.size();
+        const char* object = reinterpret_cast<const char*>(&str);
+        if (str.data() >= object && str.data() < object + sizeof(String))
+            nodes -= str.size();
+        else
+            slack += str.capacity() + 1 - str.size();
+    }
+};
+
+struct IniMemoryUsage
+{
+    IniMemoryFootprint total;
+    map<string, IniMemoryFootprint> sections;  // sezioni in minuscolo; la somma puo' essere minore di total
+    size_t retainedBuffer = 0;      // CommentMode::Lazy: buffer del load e indice dei commenti, compreso in total.comments
+};
+
+// nodo di un albero rosso-nero (std::map): colore e tre puntatori prima del valore, in tutte le implementazioni note
+template <typename Map>
+constexpr size_t iniTreeNodeBytes = 4 * sizeof(void*) + sizeof(typename Map::value_type);
+
+#endif //INIMANAGER_INIMEMORYUSAGE_H
@@ -0,0 +1,519 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INIPOLICIES_H
+#define INIMANAGER_INIPOLICIES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "IniMemoryUsage.h"
+
+using namespace std;
+
+// Policy di BasicIniFile. Ognuna e' una struct senza stato: cio' che non serve sparisce a tempo di compilazione.
+
+// Confronto tra nomi come string_view: le mappe accettano string, pmr::string e string_view senza copie
+struct IniNameLess
+{
+    using is_transparent = void;
+
+    bool operator()(string_view a, string_view b) const noexcept
+    {
+        return a < b;
+    }
+};
+
+// --- maiuscole e minuscole ---
+
+struct IniCaseInsensitive
+{
+    static constexpr bool foldsCase = true;
+
+    template <typename String>
+    static void fold(String& name)
+    {
+        transform(name.begin(), name.end(), name.begin(), ::tolower);
+    }
+};
+
+struct IniCaseSensitive
+{
+    static constexpr bool foldsCase = false;
+
+    template <typename String>
+    static void fold(String&)
+    {
+    }
+};
+
+// --- commenti ---
+
+struct IniKeepComments
+{
+    static constexpr bool keepsComments = true;
+};
+
+struct IniDropComments      // i commenti vengono saltati dal parser e non occupano memoria
+{
+    static constexpr bool keepsComments = false;
+};
+
+// --- contenitore di sezioni e chiavi ---
+
+// Vettore ordinato di coppie: ricerche binarie su memoria contigua, inserimenti O(n) tranne che in coda.
+// Come in std::map le chiavi sono ordinate, ma ogni inserimento o cancellazione invalida gli iteratori.
+template <typename Key, typename Value, typename Allocator>
+class IniFlatMap
+{
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = pair<Key, Value>;
+        using allocator_type = Allocator;
+        using iterator = typename vector<value_type, Allocator>::iterator;
+        using const_iterator = typename vector<value_type, Allocator>::const_iterator;
+
+        // costruttori con allocatore: con pmr le sezioni e le chiavi ricevono la risorsa del contenitore
+        IniFlatMap() = default;
+        explicit IniFlatMap(const Allocator& allocator) : items(allocator) {}
+        IniFlatMap(const IniFlatMap& other) = default;
+        IniFlatMap(const IniFlatMap& other, const Allocator& allocator) : items(other.items, allocator) {}
+        IniFlatMap(IniFlatMap&& other) noexcept = default;
+        IniFlatMap(IniFlatMap&& other, const Allocator& allocator) : items(std::move(other.items), allocator) {}
+        IniFlatMap& operator=(const IniFlatMap& other) = default;
+        IniFlatMap& operator=(IniFlatMap&& other) = default;
+
+        allocator_type get_allocator() const { return items.get_allocator(); }
+        void swap(IniFlatMap& other) noexcept { items.swap(other.items); }
+        iterator begin() { return items.begin(); }
+        iterator end() { return items.end(); }
+        const_iterator begin() const { return items.begin(); }
+        const_iterator end() const { return items.end(); }
+        size_t size() const { return items.size(); }
+        size_t capacity() const { return items.capacity(); }
+        bool empty() const { return items.empty(); }
+
+        template <typename Name>
+        iterator find(const Name& name)
+        {
+            string_view key(name);
+            auto it = lowerBound(key);
+            return it != items.end() && string_view(it->first) == key ? it : items.end();
+        }
+
+        template <typename Name>
+        const_iterator find(const Name& name) const
+        {
+            return const_cast<IniFlatMap*>(this)->find(name);
+        }
+
+        pair<iterator, bool> try_emplace(const Key& key)
+        {
+            auto it = lowerBound(key);
+            if (it != items.end() && it->first == key)
+                return {it, false};
+            return {items.emplace(it, key, Value()), true};
+        }
+
+        template <typename V>
+        pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+        {
+            auto inserted = try_emplace(key);
+            inserted.first->second = std::forward<V>(value);
+            return inserted;
+        }
+
+        iterator erase(const_iterator it)
+        {
+            return items.erase(it);
+        }
+
+    private:
+        vector<value_type, Allocator> items;
+
+        iterator lowerBound(string_view key)
+        {
+            // i file INI sono quasi sempre gia' ordinati: si controlla prima la coda
+            if (items.empty() || string_view(items.back().first) < key)
+                return items.end();
+            return lower_bound(items.begin(), items.end(), key,
+                               [](const value_type& item, string_view k) { return string_view(item.first) < k; });
+        }
+};
+
+// Contenitore adattivo: fino a Threshold elementi e' un vettore ordinato con ricerca lineare, come IniFlatMap
+// ma senza ricerca binaria (su pochi nomi vince la scansione); oltre la soglia gli elementi restano nel vettore
+// e si aggiunge un indice hash a indirizzamento aperto, cosi' le ricerche non dipendono piu' dalla dimensione.
+// Dopo la promozione i nuovi elementi vanno in coda e le cancellazioni spostano l'ultimo al posto del rimosso, cosi'
+// ogni modifica tocca un solo slot dell'indice; ordered() dice se il vettore e' ancora ordinato e restoreOrder()
+// lo riordina in O(n log n). Una sezione promossa resta tale.
+template <typename Key, typename Value, typename Allocator, size_t Threshold>
+class IniAdaptiveMap
+{
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = pair<Key, Value>;
+        using allocator_type = Allocator;
+        using iterator = typename vector<value_type, Allocator>::iterator;
+        using const_iterator = typename vector<value_type, Allocator>::const_iterator;
+
+        IniAdaptiveMap() = default;
+        explicit IniAdaptiveMap(const Allocator& allocator) : items(allocator), index(allocator) {}
+        IniAdaptiveMap(const IniAdaptiveMap& other) = default;
+        IniAdaptiveMap(const IniAdaptiveMap& other, const Allocator& allocator)
+            : items(other.items, allocator), index(other.index, allocator), outOfOrder(other.outOfOrder) {}
+        IniAdaptiveMap(IniAdaptiveMap&& other) noexcept = default;
+        IniAdaptiveMap(IniAdaptiveMap&& other, const Allocator& allocator)
+            : items(std::move(other.items), allocator), index(std::move(other.index), allocator),
+              outOfOrder(other.outOfOrder) {}
+        IniAdaptiveMap& operator=(const IniAdaptiveMap& other) = default;
+        IniAdaptiveMap& operator=(IniAdaptiveMap&& other) = default;
+
+        allocator_type get_allocator() const { return items.get_allocator(); }
+
+        void swap(IniAdaptiveMap& other) noexcept
+        {
+            items.swap(other.items);
+            index.swap(other.index);
+            std::swap(outOfOrder, other.outOfOrder);
+        }
+
+        iterator begin() { return items.begin(); }
+        iterator end() { return items.end(); }
+        const_iterator begin() const { return items.begin(); }
+        const_iterator end() const { return items.end(); }
+        size_t size() const { return items.size(); }
+        bool empty() const { return items.empty(); }
+        size_t capacity() const { return items.capacity(); }
+        size_t indexCapacity() const { return index.capacity(); }
+        bool hashed() const { return !index.empty(); }
+        bool ordered() const { return !outOfOrder; }
+
+        void restoreOrder()
+        {
+            if (!outOfOrder)
+                return;
+            sort(items.begin(), items.end(), [](const value_type& a, const value_type& b) { return a.first < b.first; });
+            rebuildIndex(index.size());
+            outOfOrder = false;
+        }
+
+        template <typename Name>
+        iterator find(const Name& name)
+        {
+            string_view key(name);
+            if (hashed())
+            {
+                size_t slot = findSlot(key);
+                return index[slot] == emptySlot ? items.end() : items.begin() + index[slot];
+            }
+
+            for (auto it = items.begin(); it != items.end(); ++it)
+            {
+                int order = string_view(it->first).compare(key);
+                if (order == 0)
+                    return it;
+                if (order > 0)
+                    break;
+            }
+            return items.end();
+        }
+
+        template <typename Name>
+        const_iterator find(const Name& name) const
+        {
+            return const_cast<IniAdaptiveMap*>(this)->find(name);
+        }
+
+        pair<iterator, bool> try_emplace(const Key& key)
+        {
+            if (hashed())
+            {
+                size_t slot = findSlot(key);
+                if (index[slot] != emptySlot)
+                    return {items.begin() + index[slot], false};
+
+                if (!items.empty() && key < items.back().first)
+                    outOfOrder = true;
+                items.emplace_back(key, Value());
+                if (items.size() * 2 > index.size())
+                    rebuildIndex(index.size() * 2);     // fattore di carico al piu' 1/2
+                else
+                    index[slot] = static_cast<uint32_t>(items.size() - 1);
+                return {items.end() - 1, true};
+            }
+
+            auto it = items.begin();
+            while (it != items.end() && it->first < key)
+                ++it;
+            if (it != items.end() && it->first == key)
+                return {it, false};
+
+            it = items.emplace(it, key, Value());
+            if (items.size() > Threshold)
+            {
+                size_t position = static_cast<size_t>(it - items.begin());
+                rebuildIndex(tableSizeFor(items.size()));
+                it = items.begin() + static_cast<ptrdiff_t>(position);
+            }
+            return {it, true};
+        }
+
+        template <typename V>
+        pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+        {
+            auto inserted = try_emplace(key);
+            inserted.first->second = std::forward<V>(value);
+            return inserted;
+        }
+
+        iterator erase(const_iterator it)
+        {
+            auto position = static_cast<size_t>(it - items.cbegin());
+            if (!hashed())
+                return items.erase(it);
+
+            // tolto dall'indice, al suo posto va l'ultimo elemento: niente spostamenti in mezzo al vettore
+            removeSlot(findSlot(items[position].first));
+            size_t last = items.size() - 1;
+            if (position != last)
+            {
+                index[findSlot(items[last].first)] = static_cast<uint32_t>(position);
+                items[position] = std::move(items[last]);
+                outOfOrder = true;
+            }
+            items.pop_back();
+            return items.begin() + static_cast<ptrdiff_t>(position);
+        }
+
+    private:
+        using Index = vector<uint32_t, typename allocator_traits<Allocator>::template rebind_alloc<uint32_t>>;
+        static constexpr uint32_t emptySlot = UINT32_MAX;
+
+        vector<value_type, Allocator> items;
+        Index index;        // potenza di due, vuoto finche' la sezione resta sotto la soglia
+        bool outOfOrder = false;    // solo dopo la promozione
+
+        static size_t hashOf(string_view key)
+        {
+            return hash<string_view>()(key);
+        }
+
+        static size_t tableSizeFor(size_t count)
+        {
+            size_t size = 16;
+            while (size < count * 2 + 2)
+                size *= 2;
+            return size;
+        }
+
+        // slot con la chiave, oppure il primo slot vuoto della sua sequenza di probing
+        size_t findSlot(string_view key) const
+        {
+            size_t mask = index.size() - 1;
+            for (size_t slot = hashOf(key) & mask;; slot = (slot + 1) & mask)
+            {
+                if (index[slot] == emptySlot || string_view(items[index[slot]].first) == key)
+                    return slot;
+            }
+        }
+
+        // cancellazione con spostamento all'indietro: nessuna lapide, le sequenze di probing restano corte
+        void removeSlot(size_t hole)
+        {
+            size_t mask = index.size() - 1;
+            index[hole] = emptySlot;
+            for (size_t slot = (hole + 1) & mask; index[slot] != emptySlot; slot = (slot + 1) & mask)
+            {
+                size_t home = hashOf(items[index[slot]].first) & mask;
+                if (((slot - home) & mask) >= ((slot - hole) & mask))
+                {
+                    index[hole] = index[slot];
+                    index[slot] = emptySlot;
+                    hole = slot;
+                }
+            }
+        }
+
+        void rebuildIndex(size_t tableSize)
+        {
+            index.assign(tableSize, emptySlot);
+            size_t mask = tableSize - 1;
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                size_t slot = hashOf(items[i].first) & mask;
+                while (index[slot] != emptySlot)
+                    slot = (slot + 1) & mask;
+                index[slot] = static_cast<uint32_t>(i);
+            }
+        }
+};
+
+// nodeBytes e addContainer servono a BasicIniFile::memoryUsage: byte per elemento e costo fisso del contenitore;
+// sorted dice se l'iterazione segue l'ordine dei nomi (diff e hasKey ne approfittano), heterogeneousLookup se
+// le ricerche accettano una std::string al posto della chiave allocata con l'allocatore del file.
+// inOrder dice se un contenitore in questo momento si percorre gia' in ordine di nome; restoreOrder lo riordina
+// e va chiamata solo da chi scrive, perche' le sezioni sono condivise tra le copie
+
+struct IniOrderedStorage
+{
+    static constexpr bool sorted = true;
+    static constexpr bool heterogeneousLookup = true;
+
+    template <typename Key, typename Value, typename Allocator>
+    using Map = map<Key, Value, IniNameLess,
+                    typename allocator_traits<Allocator>::template rebind_alloc<pair<const Key, Value>>>;
+
+    template <typename Map>
+    static constexpr size_t nodeBytes = iniTreeNodeBytes<Map>;
+
+    template <typename Map>
+    static void addContainer(const Map&, IniMemoryFootprint&)
+    {
+    }
+
+    template <typename Map>
+    static bool inOrder(const Map&)
+    {
+        return true;
+    }
+
+    template <typename Map>
+    static void restoreOrder(Map&)
+    {
+    }
+};
+
+struct IniFlatStorage
+{
+    static constexpr bool sorted = true;
+    static constexpr bool heterogeneousLookup = true;
+
+    template <typename Key, typename Value, typename Allocator>
+    using Map = IniFlatMap<Key, Value, typename allocator_traits<Allocator>::template rebind_alloc<pair<Key, Value>>>;
+
+    template <typename Map>
+    static constexpr size_t nodeBytes = sizeof(typename Map::value_type);
+
+    template <typename Map>
+    static void addContainer(const Map& map, IniMemoryFootprint& footprint)
+    {
+        footprint.slack += (map.capacity() - map.size()) * sizeof(typename Map::value_type);
+    }
+
+    template <typename Map>
+    static bool inOrder(const Map&)
+    {
+        return true;
+    }
+
+    template <typename Map>
+    static void restoreOrder(Map&)
+    {
+    }
+};
+
+struct IniHashStorage       // niente ordinamento: save() e print() seguono l'ordine della tabella
+{
+    static constexpr bool sorted = false;
+    static constexpr bool heterogeneousLookup = false;
+
+    struct Hash
+    {
+        template <typename String>
+        size_t operator()(const String& name) const
+        {
+            return hash<string_view>()(string_view(name.data(), name.size()));
+        }
+    };
+
+    template <typename Key, typename Value, typename Allocator>
+    using Map = unordered_map<Key, Value, Hash, equal_to<Key>,
+                              typename allocator_traits<Allocator>::template rebind_alloc<pair<const Key, Value>>>;
+
+    // puntatore al successivo e hash memorizzato accanto al valore
+    template <typename Map>
+    static constexpr size_t nodeBytes = sizeof(void*) + sizeof(typename Map::value_type) + sizeof(size_t);
+
+    template <typename Map>
+    static void addContainer(const Map& map, IniMemoryFootprint& footprint)
+    {
+        footprint.nodes += map.bucket_count() * sizeof(void*);
+    }
+
+    template <typename Map>
+    static bool inOrder(const Map&)
+    {
+        return false;
+    }
+
+    template <typename Map>
+    static void restoreOrder(Map&)
+    {
+    }
+};
+
+// Threshold: numero di chiavi oltre il quale una sezione passa all'indice hash (vedi BM_SectionGet e BM_SectionLoad)
+template <size_t Threshold = 16>
+struct IniAdaptiveStorage
+{
+    static constexpr bool sorted = true;       // dopo restoreOrder: load e commit la chiamano, set e deleteKey no
+    static constexpr bool heterogeneousLookup = true;
+
+    template <typename Key, typename Value, typename Allocator>
+    using Map = IniAdaptiveMap<Key, Value, typename allocator_traits<Allocator>::template rebind_alloc<pair<Key, Value>>,
+                               Threshold>;
+
+    template <typename Map>
+    static constexpr size_t nodeBytes = sizeof(typename Map::value_type);
+
+    template <typename Map>
+    static void addContainer(const Map& map, IniMemoryFootprint& footprint)
+    {
+        footprint.slack += (map.capacity() - map.size()) * sizeof(typename Map::value_type);
+        footprint.nodes += map.indexCapacity() * sizeof(uint32_t);
+    }
+
+    template <typename Map>
+    static bool inOrder(const Map& map)
+    {
+        return map.ordered();
+    }
+
+    template <typename Map>
+    static void restoreOrder(Map& map)
+    {
+        map.restoreOrder();
+    }
+};
+
+// --- sincronizzazione ---
+
+struct IniNoLocking
+{
+    struct Mutex        // lock vuoti: con l'inlining non resta nulla
+    {
+        void lock() {}
+        void unlock() {}
+        void lock_shared() {}
+        void unlock_shared() {}
+    };
+};
+
+struct IniSharedLocking     // letture concorrenti, scritture esclusive; getView non e' protetta oltre la chiamata
+{
+    using Mutex = shared_mutex;
+};
+
+#endif //INIMANAGER_INIPOLICIES_H
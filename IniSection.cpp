@@ -0,0 +1,7 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniSection.h"
+
+template class BasicIniSection<IniSection::Keys>;
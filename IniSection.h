@@ -0,0 +1,167 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INISECTION_H
+#define INIMANAGER_INISECTION_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include "IniPolicies.h"
+
+using namespace std;
+
+// Chiavi di una sezione condivise copy-on-write: copiare un IniFile copia solo questi puntatori e la
+// prima modifica a una sezione condivisa la clona (edit). Le letture passano dall'interfaccia const,
+// che si comporta come la mappa. Il conteggio dei riferimenti e' atomico, quindi le copie possono
+// passare ad altri thread; la stessa copia invece non va letta e modificata insieme, come prima.
+// KeyMap e' il contenitore di chiavi scelto dallo StoragePolicy di BasicIniFile.
+template <typename KeyMap>
+class BasicIniSection
+{
+    public:
+        using Keys = KeyMap;
+        using allocator_type = typename allocator_traits<typename Keys::allocator_type>::template rebind_alloc<char>;
+        using const_iterator = typename Keys::const_iterator;
+
+        // mappa e blocco di controllo di allocate_shared, per BasicIniFile::memoryUsage
+        static constexpr size_t sharedBlockBytes = sizeof(Keys) + 2 * sizeof(void*);
+
+        BasicIniSection() = default;
+
+        explicit BasicIniSection(const allocator_type& allocator) : allocator(allocator)
+        {
+        }
+
+        BasicIniSection(const BasicIniSection& other) = default;
+
+        BasicIniSection(const BasicIniSection& other, const allocator_type& allocator)    // in un altro allocatore: copia profonda
+            : shared(share(other.shared, other.allocator, allocator)), allocator(allocator)
+        {
+        }
+
+        BasicIniSection(Keys keys, const allocator_type& allocator) : shared(make(allocator, std::move(keys))), allocator(allocator)
+        {
+        }
+
+        BasicIniSection(BasicIniSection&& other) noexcept = default;
+
+        BasicIniSection(BasicIniSection&& other, const allocator_type& allocator) : allocator(allocator)
+        {
+            *this = std::move(other);
+        }
+
+        BasicIniSection& operator=(const BasicIniSection& other)     // come i contenitori pmr, l'allocatore resta questo
+        {
+            shared = share(other.shared, other.allocator, allocator);
+            return *this;
+        }
+
+        BasicIniSection& operator=(BasicIniSection&& other)
+        {
+            if (other.allocator == allocator)
+                shared = std::move(other.shared);
+            else
+                shared = share(other.shared, other.allocator, allocator);
+            return *this;
+        }
+
+        const Keys& keys() const
+        {
+            static const Keys empty;
+            return shared ? *shared : empty;
+        }
+
+        Keys& edit()            // clona le chiavi se sono condivise con un'altra copia
+        {
+            if (!shared)
+                shared = make(allocator);
+            else if (!unique())
+                shared = make(allocator, *shared);
+            return *shared;
+        }
+
+        Keys take()             // le sposta fuori se nessun'altra copia le condivide, altrimenti le copia
+        {
+            Keys keys{typename Keys::allocator_type(allocator)};
+            if (shared && unique())
+                keys = std::move(*shared);
+            else if (shared)
+                keys = *shared;
+            shared.reset();
+            return keys;
+        }
+
+        bool shares(const BasicIniSection& other) const
+        {
+            return shared != nullptr && shared == other.shared;
+        }
+
+        bool allocated() const
+        {
+            return shared != nullptr;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator;
+        }
+
+        const_iterator begin() const { return keys().begin(); }
+        const_iterator end() const { return keys().end(); }
+        size_t size() const { return keys().size(); }
+        bool empty() const { return keys().empty(); }
+
+        template <typename Name>
+        size_t count(const Name& key) const { return keys().find(key) != keys().end(); }
+
+        template <typename Name>
+        const_iterator find(const Name& key) const { return keys().find(key); }
+
+    private:
+        using BlockAllocator = typename allocator_traits<allocator_type>::template rebind_alloc<Keys>;
+
+        shared_ptr<Keys> shared;        // nullptr finche' la sezione e' vuota e mai modificata
+        allocator_type allocator;
+
+        template <typename... Args>
+        static shared_ptr<Keys> make(const allocator_type& allocator, Args&&... args)
+        {
+            // polymorphic_allocator passa da solo la risorsa alla mappa (costruzione uses-allocator),
+            // gli altri allocatori vanno consegnati esplicitamente
+            if constexpr (is_same_v<BlockAllocator, pmr::polymorphic_allocator<Keys>>)
+                return allocate_shared<Keys>(BlockAllocator(allocator), std::forward<Args>(args)...);
+            else
+                return allocate_shared<Keys>(BlockAllocator(allocator), std::forward<Args>(args)...,
+                                             typename Keys::allocator_type(allocator));
+        }
+
+        bool unique() const
+        {
+            if (shared.use_count() != 1)
+                return false;
+            // use_count e' una lettura relaxed: la fence ordina le letture di chi ha appena rilasciato
+            // l'ultima altra copia prima delle modifiche che seguono
+            atomic_thread_fence(memory_order_acquire);
+            return true;
+        }
+
+        static shared_ptr<Keys> share(const shared_ptr<Keys>& keys, const allocator_type& from, const allocator_type& to)
+        {
+            // le chiavi si condividono solo con lo stesso allocatore, altrimenti vivrebbero nella risorsa sbagliata
+            if (!keys || from == to)
+                return keys;
+            return make(to, *keys);
+        }
+};
+
+// sezione di IniFile: mappa ordinata in una risorsa pmr
+using IniSection = BasicIniSection<IniOrderedStorage::Map<pmr::string, pmr::string, pmr::polymorphic_allocator<char>>>;
+
+extern template class BasicIniSection<IniSection::Keys>;
+
+#endif //INIMANAGER_INISECTION_H
@@ -0,0 +1,408 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniSnapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void IniSnapshot::write(const IniFile& ini, const string& snapshotFile, const FileFingerprint& source)
+{
+    ini.materializeComments();
+    uint64_t keyCount = 0;
+    uint64_t blobSize = 0;
+    for (const auto& section : ini.data)
+    {
+        keyCount += section.second.size();
+        blobSize += section.first.size();
+        for (const auto& key : section.second)
+            blobSize += key.first.size() + key.second.size();
+    }
+    for (const auto& comment : ini.sectionComments)
+        blobSize += comment.second.size();
+    for (const auto& section : ini.keyComments)
+    {
+        for (const auto& comment : section.second)
+            blobSize += comment.second.size();
+    }
+
+    uint64_t sectionTable = sizeof(Header);
+    uint64_t keyTable = sectionTable + ini.data.size() * sizeof(SectionEntry);
+    uint64_t blob = keyTable + keyCount * sizeof(KeyEntry);
+    uint64_t totalSize = blob + blobSize;
+    if (totalSize > UINT32_MAX)
+        throw runtime_error("INI file too large for a snapshot: " + to_string(totalSize) + " bytes");
+
+    vector<unsigned char> out(totalSize);
+    auto appendString = [&out, &blob](string_view str)
+    {
+        memcpy(out.data() + blob, str.data(), str.size());
+        auto offset = static_cast<uint32_t>(blob);
+        blob += str.size();
+        return offset;
+    };
+
+    auto* sectionEntries = reinterpret_cast<SectionEntry*>(out.data() + sectionTable);
+    auto* keyEntries = reinterpret_cast<KeyEntry*>(out.data() + keyTable);
+    uint32_t keyIndex = 0;
+    for (const auto& section : ini.data)
+    {
+        SectionEntry& entry = *sectionEntries++;
+        entry.nameOffset = appendString(section.first);
+        entry.nameLength = static_cast<uint32_t>(section.first.size());
+        entry.commentOffset = entry.commentLength = 0;
+        entry.firstKey = keyIndex;
+        entry.keyCount = static_cast<uint32_t>(section.second.size());
+
+        auto sectionComment = ini.sectionComments.find(section.first);
+        if (sectionComment != ini.sectionComments.end())
+        {
+            entry.commentOffset = appendString(sectionComment->second);
+            entry.commentLength = static_cast<uint32_t>(sectionComment->second.size());
+        }
+
+        auto keyComments = ini.keyComments.find(section.first);
+        for (const auto& key : section.second)
+        {
+            KeyEntry& keyEntry = keyEntries[keyIndex++];
+            keyEntry.nameOffset = appendString(key.first);
+            keyEntry.nameLength = static_cast<uint32_t>(key.first.size());
+            keyEntry.valueOffset = appendString(key.second);
+            keyEntry.valueLength = static_cast<uint32_t>(key.second.size());
+            keyEntry.commentOffset = keyEntry.commentLength = 0;
+
+            if (keyComments != ini.keyComments.end())
+            {
+                auto keyComment = keyComments->second.find(key.first);
+                if (keyComment != keyComments->second.end())
+                {
+                    keyEntry.commentOffset = appendString(keyComment->second);
+                    keyEntry.commentLength = static_cast<uint32_t>(keyComment->second.size());
+                }
+            }
+        }
+    }
+
+    // i commenti di sezioni inesistenti sono stati contati ma non scritti: lo snapshot viene accorciato
+    totalSize = blob;
+    out.resize(totalSize);
+
+    Header header{};
+    header.magic = snapshotMagic;
+    header.layoutVersion = snapshotLayoutVersion;
+    header.sectionCount = static_cast<uint32_t>(ini.data.size());
+    header.keyCount = keyCount;
+    header.totalSize = totalSize;
+    header.sourceMtime = source.mtime;
+    header.sourceSize = source.size;
+    header.sourceHash = source.hash;
+    header.checksum = FileFingerprint::hashBytes(reinterpret_cast<const char*>(out.data()) + sizeof(Header),
+                                                 totalSize - sizeof(Header));
+    memcpy(out.data(), &header, sizeof(header));
+
+    // scrittura su un file temporaneo e rename: chi apre lo snapshot non lo vede mai a meta'
+    string temporary = snapshotFile + ".tmp" + to_string(getpid());
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == nullptr)
+        throw runtime_error("Unable to open file for writing: " + temporary);
+
+    bool written = fwrite(out.data(), 1, out.size(), file) == out.size();
+    written = fclose(file) == 0 && written;
+    if (!written || rename(temporary.c_str(), snapshotFile.c_str()) != 0)
+    {
+        unlink(temporary.c_str());
+        throw runtime_error("Error writing to the file: " + snapshotFile);
+    }
+}
+
+IniSnapshot IniSnapshot::open(const string& snapshotFile, bool verifyChecksum)
+{
+    int fd = ::open(snapshotFile.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw runtime_error("Unable to open file: " + snapshotFile);
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header))
+    {
+        close(fd);
+        throw runtime_error("Invalid INI snapshot: " + snapshotFile);
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        throw runtime_error("Unable to map INI snapshot: " + snapshotFile);
+
+    IniSnapshot snapshot(static_cast<const unsigned char*>(mapped), size);
+    const Header& header = snapshot.header();
+    if (header.magic != snapshotMagic || header.layoutVersion != snapshotLayoutVersion || header.totalSize != size)
+        throw runtime_error("Invalid INI snapshot: " + snapshotFile);
+
+    if (verifyChecksum)
+    {
+        uint64_t checksum = FileFingerprint::hashBytes(reinterpret_cast<const char*>(snapshot.base) + sizeof(Header),
+                                                       size - sizeof(Header));
+        if (checksum != header.checksum || !snapshot.validate())
+            throw runtime_error("Corrupted INI snapshot: " + snapshotFile);
+    }
+
+    return snapshot;
+}
+
+IniSnapshot IniSnapshot::openFor(const string& sourceFile)
+{
+    return openFor(sourceFile, defaultPath(sourceFile));
+}
+
+IniSnapshot IniSnapshot::openFor(const string& sourceFile, const string& snapshotFile)
+{
+    if (isFresh(snapshotFile, sourceFile))
+    {
+        try
+        {
+            return open(snapshotFile);
+        }
+        catch (const runtime_error&)
+        {
+            // snapshot illeggibile o corrotto: si ricostruisce dal testo
+        }
+    }
+
+    FileFingerprint source = FileFingerprint::of(sourceFile);
+    IniFile ini;
+    ini.load(sourceFile);
+    write(ini, snapshotFile, source);
+
+    IniSnapshot snapshot = open(snapshotFile, false);
+    snapshot.parsedText = true;
+    return snapshot;
+}
+
+bool IniSnapshot::isFresh(const string& snapshotFile, const string& sourceFile)
+{
+    Header header{};
+    if (!readHeader(snapshotFile, header))
+        return false;
+
+    FileFingerprint current = FileFingerprint::stat(sourceFile);
+    if (!current.exists || current.size != header.sourceSize)
+        return false;
+    if (current.mtime == header.sourceMtime)
+        return true;
+
+    // mtime cambiato ma stessa dimensione: decide l'hash del contenuto (es. dopo un touch)
+    return FileFingerprint::hashFile(sourceFile) == header.sourceHash;
+}
+
+string IniSnapshot::defaultPath(const string& sourceFile)
+{
+    return sourceFile + ".snap";
+}
+
+IniSnapshot::IniSnapshot(const unsigned char* base, size_t mappedSize) : base(base), mappedSize(mappedSize)
+{
+}
+
+IniSnapshot::IniSnapshot(IniSnapshot&& other) noexcept
+    : base(other.base), mappedSize(other.mappedSize), parsedText(other.parsedText)
+{
+    other.base = nullptr;
+    other.mappedSize = 0;
+}
+
+IniSnapshot& IniSnapshot::operator=(IniSnapshot&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (base != nullptr)
+            munmap(const_cast<unsigned char*>(base), mappedSize);
+        base = other.base;
+        mappedSize = other.mappedSize;
+        parsedText = other.parsedText;
+        other.base = nullptr;
+        other.mappedSize = 0;
+    }
+    return *this;
+}
+
+IniSnapshot::~IniSnapshot()
+{
+    if (base != nullptr)
+        munmap(const_cast<unsigned char*>(base), mappedSize);
+}
+
+string IniSnapshot::get(const string& section, const string& key) const
+{
+    return string(getView(section, key));
+}
+
+string_view IniSnapshot::getView(const string& section, const string& key) const
+{
+    const KeyEntry* entry = findKey(findSection(section), key);
+    return entry != nullptr ? text(entry->valueOffset, entry->valueLength) : string_view();
+}
+
+bool IniSnapshot::hasSection(const string& section) const
+{
+    return findSection(section) != nullptr;
+}
+
+bool IniSnapshot::hasKey(const string& section, const string& key) const
+{
+    return findKey(findSection(section), key) != nullptr;
+}
+
+string_view IniSnapshot::getSectionComment(const string& section) const
+{
+    const SectionEntry* entry = findSection(section);
+    return entry != nullptr ? text(entry->commentOffset, entry->commentLength) : string_view();
+}
+
+string_view IniSnapshot::getKeyComment(const string& section, const string& key) const
+{
+    const KeyEntry* entry = findKey(findSection(section), key);
+    return entry != nullptr ? text(entry->commentOffset, entry->commentLength) : string_view();
+}
+
+size_t IniSnapshot::sectionCount() const
+{
+    return header().sectionCount;
+}
+
+size_t IniSnapshot::keyCount() const
+{
+    return header().keyCount;
+}
+
+FileFingerprint IniSnapshot::source() const
+{
+    FileFingerprint fingerprint;
+    fingerprint.exists = true;
+    fingerprint.mtime = header().sourceMtime;
+    fingerprint.size = header().sourceSize;
+    fingerprint.hash = header().sourceHash;
+    return fingerprint;
+}
+
+bool IniSnapshot::fromText() const
+{
+    return parsedText;
+}
+
+IniFile IniSnapshot::toIniFile() const
+{
+    IniFile ini;
+    for (uint32_t s = 0; s < header().sectionCount; s++)
+    {
+        const SectionEntry& section = sections()[s];
+        IniFile::String name(text(section.nameOffset, section.nameLength));
+        auto& keyMap = ini.data[name].edit();
+        if (section.commentLength > 0)
+            ini.sectionComments[name] = text(section.commentOffset, section.commentLength);
+
+        for (uint32_t k = section.firstKey; k < section.firstKey + section.keyCount; k++)
+        {
+            const KeyEntry& key = keys()[k];
+            IniFile::String keyName(text(key.nameOffset, key.nameLength));
+            if (key.commentLength > 0)
+                ini.keyComments[name].edit()[keyName] = text(key.commentOffset, key.commentLength);
+            keyMap.emplace_hint(keyMap.end(), std::move(keyName), text(key.valueOffset, key.valueLength));
+        }
+    }
+
+    return ini;
+}
+
+const IniSnapshot::Header& IniSnapshot::header() const
+{
+    return *reinterpret_cast<const Header*>(base);
+}
+
+const IniSnapshot::SectionEntry* IniSnapshot::sections() const
+{
+    return reinterpret_cast<const SectionEntry*>(base + sizeof(Header));
+}
+
+const IniSnapshot::KeyEntry* IniSnapshot::keys() const
+{
+    return reinterpret_cast<const KeyEntry*>(base + sizeof(Header) + header().sectionCount * sizeof(SectionEntry));
+}
+
+string_view IniSnapshot::text(uint32_t offset, uint32_t length) const
+{
+    return {reinterpret_cast<const char*>(base + offset), length};
+}
+
+const IniSnapshot::SectionEntry* IniSnapshot::findSection(const string& section) const
+{
+    const string& folded = IniFile::foldForLookup(section);
+    const SectionEntry* first = sections();
+    const SectionEntry* last = first + header().sectionCount;
+
+    auto it = lower_bound(first, last, folded, [this](const SectionEntry& entry, const string& name)
+    {
+        return text(entry.nameOffset, entry.nameLength) < name;
+    });
+
+    return it != last && text(it->nameOffset, it->nameLength) == folded ? it : nullptr;
+}
+
+const IniSnapshot::KeyEntry* IniSnapshot::findKey(const SectionEntry* section, const string& key) const
+{
+    if (section == nullptr)
+        return nullptr;
+
+    const string& folded = IniFile::foldForLookup(key);
+    const KeyEntry* first = keys() + section->firstKey;
+    const KeyEntry* last = first + section->keyCount;
+
+    auto it = lower_bound(first, last, folded, [this](const KeyEntry& entry, const string& name)
+    {
+        return text(entry.nameOffset, entry.nameLength) < name;
+    });
+
+    return it != last && text(it->nameOffset, it->nameLength) == folded ? it : nullptr;
+}
+
+bool IniSnapshot::validate() const
+{
+    // un file corrotto non deve poter far leggere fuori dalla mappatura
+    const Header& h = header();
+    uint64_t keyTable = sizeof(Header) + uint64_t(h.sectionCount) * sizeof(SectionEntry);
+    if (keyTable + h.keyCount * sizeof(KeyEntry) > mappedSize)
+        return false;
+
+    auto inBounds = [this](uint32_t offset, uint32_t length) { return uint64_t(offset) + length <= mappedSize; };
+    for (uint32_t s = 0; s < h.sectionCount; s++)
+    {
+        const SectionEntry& section = sections()[s];
+        if (!inBounds(section.nameOffset, section.nameLength) || !inBounds(section.commentOffset, section.commentLength)
+            || uint64_t(section.firstKey) + section.keyCount > h.keyCount)
+            return false;
+    }
+    for (uint64_t k = 0; k < h.keyCount; k++)
+    {
+        const KeyEntry& key = keys()[k];
+        if (!inBounds(key.nameOffset, key.nameLength) || !inBounds(key.valueOffset, key.valueLength)
+            || !inBounds(key.commentOffset, key.commentLength))
+            return false;
+    }
+
+    return true;
+}
+
+bool IniSnapshot::readHeader(const string& snapshotFile, Header& header)
+{
+    FILE* file = fopen(snapshotFile.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    bool read = fread(&header, sizeof(header), 1, file) == 1;
+    fclose(file);
+    return read && header.magic == snapshotMagic && header.layoutVersion == snapshotLayoutVersion;
+}
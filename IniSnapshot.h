@@ -0,0 +1,97 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INISNAPSHOT_H
+#define INIMANAGER_INISNAPSHOT_H
+
+#include <cstdint>
+#include <string_view>
+#include "FileFingerprint.h"
+#include "IniFile.h"
+
+// Snapshot binario di un IniFile, pensato per essere mappato in memoria e letto cosi' com'e'.
+// Layout: intestazione, tabella delle sezioni (ordinate), tabella delle chiavi (ordinate per sezione),
+// blob con nomi, valori e commenti. Il checksum copre tutto cio' che segue l'intestazione e
+// l'impronta del file sorgente permette di capire se lo snapshot e' ancora valido.
+class IniSnapshot
+{
+    public:
+        static void write(const IniFile& ini, const string& snapshotFile, const FileFingerprint& source = {});
+        static IniSnapshot open(const string& snapshotFile, bool verifyChecksum = true);
+        static IniSnapshot openFor(const string& sourceFile);
+        static IniSnapshot openFor(const string& sourceFile, const string& snapshotFile);
+        static bool isFresh(const string& snapshotFile, const string& sourceFile);
+        static string defaultPath(const string& sourceFile);
+
+        IniSnapshot(IniSnapshot&& other) noexcept;
+        IniSnapshot& operator=(IniSnapshot&& other) noexcept;
+        IniSnapshot(const IniSnapshot&) = delete;
+        IniSnapshot& operator=(const IniSnapshot&) = delete;
+        ~IniSnapshot();
+
+        string get(const string& section, const string& key) const;
+        string_view getView(const string& section, const string& key) const;
+        bool hasSection(const string& section) const;
+        bool hasKey(const string& section, const string& key) const;
+        string_view getSectionComment(const string& section) const;
+        string_view getKeyComment(const string& section, const string& key) const;
+        size_t sectionCount() const;
+        size_t keyCount() const;
+        FileFingerprint source() const;
+        bool fromText() const;      // true se openFor ha dovuto analizzare il testo
+        IniFile toIniFile() const;
+
+    private:
+        struct Header
+        {
+            uint64_t magic;
+            uint32_t layoutVersion;
+            uint32_t sectionCount;
+            uint64_t keyCount;
+            uint64_t totalSize;
+            uint64_t checksum;          // FNV-1a dei byte successivi all'intestazione
+            int64_t sourceMtime;
+            uint64_t sourceSize;
+            uint64_t sourceHash;
+        };
+
+        struct SectionEntry
+        {
+            uint32_t nameOffset;
+            uint32_t nameLength;
+            uint32_t commentOffset;
+            uint32_t commentLength;
+            uint32_t firstKey;
+            uint32_t keyCount;
+        };
+
+        struct KeyEntry
+        {
+            uint32_t nameOffset;
+            uint32_t nameLength;
+            uint32_t valueOffset;
+            uint32_t valueLength;
+            uint32_t commentOffset;
+            uint32_t commentLength;
+        };
+
+        static constexpr uint64_t snapshotMagic = 0x494e494d534e4150ULL;  // "INIMSNAP"
+        static constexpr uint32_t snapshotLayoutVersion = 1;
+
+        const unsigned char* base = nullptr;
+        size_t mappedSize = 0;
+        bool parsedText = false;
+
+        IniSnapshot(const unsigned char* base, size_t mappedSize);
+        const Header& header() const;
+        const SectionEntry* sections() const;
+        const KeyEntry* keys() const;
+        string_view text(uint32_t offset, uint32_t length) const;
+        const SectionEntry* findSection(const string& section) const;
+        const KeyEntry* findKey(const SectionEntry* section, const string& key) const;
+        bool validate() const;
+        static bool readHeader(const string& snapshotFile, Header& header);
+};
+
+#endif //INIMANAGER_INISNAPSHOT_H
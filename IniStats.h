@@ -0,0 +1,126 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INISTATS_H
+#define INIMANAGER_INISTATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+// Fotografia delle statistiche di un IniFile. I contatori restano a zero se la libreria e' compilata
+// senza INIMANAGER_STATS; sections, keys e bytes descrivono sempre il contenuto attuale.
+struct IniFileStats
+{
+    bool enabled = false;
+
+    uint64_t getHits = 0;
+    uint64_t getMisses = 0;
+    uint64_t sets = 0;
+    uint64_t deletes = 0;
+    uint64_t allocations = 0;       // nodi di sezioni, chiavi e commenti creati
+
+    uint64_t loads = 0;
+    uint64_t bytesParsed = 0;
+    chrono::nanoseconds loadTime{0};
+    chrono::nanoseconds lastLoadTime{0};
+
+    uint64_t saves = 0;
+    uint64_t bytesWritten = 0;
+    chrono::nanoseconds saveTime{0};
+    chrono::nanoseconds lastSaveTime{0};
+
+    size_t sections = 0;
+    size_t keys = 0;
+    size_t bytes = 0;               // nomi, valori e commenti, senza l'overhead dei contenitori
+    size_t resolvedValues = 0;      // valori interpolati in cache
+    size_t resolvedReferences = 0;  // dipendenze registrate tra i valori in cache
+};
+
+#if INIMANAGER_STATS
+
+// Contatori con atomici relaxed: get e' const e puo' essere chiamata da piu' thread in lettura.
+class IniStatsCounters
+{
+    public:
+        IniStatsCounters() = default;
+        IniStatsCounters(const IniStatsCounters&) {}    // una copia parte con contatori nuovi
+        IniStatsCounters& operator=(const IniStatsCounters&) { return *this; }
+
+        static void add(atomic<uint64_t>& counter, uint64_t amount = 1)
+        {
+            counter.fetch_add(amount, memory_order_relaxed);
+        }
+
+        void fill(IniFileStats& stats) const
+        {
+            stats.enabled = true;
+            stats.getHits = getHits.load(memory_order_relaxed);
+            stats.getMisses = getMisses.load(memory_order_relaxed);
+            stats.sets = sets.load(memory_order_relaxed);
+            stats.deletes = deletes.load(memory_order_relaxed);
+            stats.allocations = allocations.load(memory_order_relaxed);
+            stats.loads = loads.load(memory_order_relaxed);
+            stats.bytesParsed = bytesParsed.load(memory_order_relaxed);
+            stats.loadTime = chrono::nanoseconds(loadNanos.load(memory_order_relaxed));
+            stats.lastLoadTime = chrono::nanoseconds(lastLoadNanos.load(memory_order_relaxed));
+            stats.saves = saves.load(memory_order_relaxed);
+            stats.bytesWritten = bytesWritten.load(memory_order_relaxed);
+            stats.saveTime = chrono::nanoseconds(saveNanos.load(memory_order_relaxed));
+            stats.lastSaveTime = chrono::nanoseconds(lastSaveNanos.load(memory_order_relaxed));
+        }
+
+        void reset()
+        {
+            for (auto* counter : {&getHits, &getMisses, &sets, &deletes, &allocations, &loads, &bytesParsed,
+                                  &loadNanos, &lastLoadNanos, &saves, &bytesWritten, &saveNanos, &lastSaveNanos})
+                counter->store(0, memory_order_relaxed);
+        }
+
+        atomic<uint64_t> getHits{0};
+        atomic<uint64_t> getMisses{0};
+        atomic<uint64_t> sets{0};
+        atomic<uint64_t> deletes{0};
+        atomic<uint64_t> allocations{0};
+        atomic<uint64_t> loads{0};
+        atomic<uint64_t> bytesParsed{0};
+        atomic<uint64_t> loadNanos{0};
+        atomic<uint64_t> lastLoadNanos{0};
+        atomic<uint64_t> saves{0};
+        atomic<uint64_t> bytesWritten{0};
+        atomic<uint64_t> saveNanos{0};
+        atomic<uint64_t> lastSaveNanos{0};
+};
+
+// misura la durata di uno scope e la somma a total, registrandola anche come ultima
+class IniStatsTimer
+{
+    public:
+        IniStatsTimer(atomic<uint64_t>& total, atomic<uint64_t>& last)
+            : total(total), last(last), start(chrono::steady_clock::now()) {}
+
+        ~IniStatsTimer()
+        {
+            auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+            IniStatsCounters::add(total, static_cast<uint64_t>(elapsed));
+            last.store(static_cast<uint64_t>(elapsed), memory_order_relaxed);
+        }
+
+    private:
+        atomic<uint64_t>& total;
+        atomic<uint64_t>& last;
+        chrono::steady_clock::time_point start;
+};
+
+#define INI_STATS(statement) statement
+
+#else
+
+#define INI_STATS(statement)
+
+#endif
+
+#endif //INIMANAGER_INISTATS_H
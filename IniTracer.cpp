@@ -0,0 +1,30 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniTracer.h"
+
+atomic<IniTracer*> IniTracer::current{nullptr};
+atomic<uint32_t> IniTracer::sampling{0};
+
+void IniTracer::install(IniTracer* tracer, uint32_t sampleEvery)
+{
+    sampling.store(sampleEvery, memory_order_relaxed);
+    current.store(tracer, memory_order_release);
+}
+
+void IniTracer::uninstall()
+{
+    install(nullptr);
+}
+
+bool IniTracer::takeSample()
+{
+    uint32_t every = sampling.load(memory_order_relaxed);
+    if (every == 0)
+        return false;
+
+    // contatore per thread: nessuna contesa tra lettori concorrenti
+    thread_local uint32_t calls = 0;
+    return calls++ % every == 0;
+}
@@ -0,0 +1,81 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INITRACER_H
+#define INIMANAGER_INITRACER_H
+
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+// Interfaccia di tracing: IniFile apre e chiude uno span per ogni fase di load, save e print e, a campione,
+// per get e set. I nomi sono stringhe letterali, valide per tutta la durata del programma.
+// Il tracer installato e' globale e deve restare vivo finche' non viene disinstallato.
+class IniTracer
+{
+    public:
+        virtual ~IniTracer() = default;
+        virtual void beginSpan(const char* name) = 0;
+        virtual void endSpan(const char* name) = 0;
+
+        // sampleEvery = N traccia una get/set ogni N per thread, 0 non le traccia affatto
+        static void install(IniTracer* tracer, uint32_t sampleEvery = 0);
+        static void uninstall();
+
+        static IniTracer* installed()
+        {
+            return current.load(memory_order_acquire);
+        }
+
+        static IniTracer* sampled()
+        {
+            IniTracer* tracer = current.load(memory_order_acquire);
+            if (tracer == nullptr)  // senza tracer il costo e' questo solo confronto
+                return nullptr;
+            return takeSample() ? tracer : nullptr;
+        }
+
+    private:
+        static atomic<IniTracer*> current;
+        static atomic<uint32_t> sampling;
+
+        static bool takeSample();
+};
+
+class IniTraceSpan
+{
+    public:
+        IniTraceSpan(const char* name, IniTracer* tracer) : name(name), tracer(tracer)
+        {
+            if (tracer != nullptr)
+                tracer->beginSpan(name);
+        }
+
+        explicit IniTraceSpan(const char* name) : IniTraceSpan(name, IniTracer::installed()) {}
+
+        ~IniTraceSpan()
+        {
+            end();
+        }
+
+        IniTraceSpan(const IniTraceSpan&) = delete;
+        IniTraceSpan& operator=(const IniTraceSpan&) = delete;
+
+        // chiude lo span prima della fine dello scope
+        void end()
+        {
+            if (tracer != nullptr)
+            {
+                tracer->endSpan(name);
+                tracer = nullptr;
+            }
+        }
+
+    private:
+        const char* name;
+        IniTracer* tracer;
+};
+
+#endif //INIMANAGER_INITRACER_H
@@ -0,0 +1,110 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "IniTransaction.h"
+
+IniTransaction& IniTransaction::set(const string& section, const string& key, const string& value)
+{
+    operations.push_back({Type::Set, section, key, value});
+    return *this;
+}
+
+IniTransaction& IniTransaction::deleteKey(const string& section, const string& key)
+{
+    operations.push_back({Type::DeleteKey, section, key, ""});
+    return *this;
+}
+
+IniTransaction& IniTransaction::deleteSection(const string& section)
+{
+    operations.push_back({Type::DeleteSection, section, "", ""});
+    return *this;
+}
+
+size_t IniTransaction::size() const
+{
+    return operations.size();
+}
+
+bool IniTransaction::empty() const
+{
+    return operations.empty();
+}
+
+void IniTransaction::clear()
+{
+    operations.clear();
+}
+
+vector<IniTransaction::SectionOperation> IniTransaction::plan(Fold fold) const
+{
+    // nomi normalizzati come nel file di destinazione, poi ordinamento stabile:
+    // all'interno della stessa sezione e chiave vale l'ordine di inserimento
+    struct Named
+    {
+        string section;
+        string key;
+        const Operation* operation;
+    };
+
+    vector<Named> sorted;
+    sorted.reserve(operations.size());
+    for (const auto& operation : operations)
+    {
+        Named named{operation.section, operation.key, &operation};
+        fold(named.section);
+        fold(named.key);
+        sorted.push_back(std::move(named));
+    }
+    stable_sort(sorted.begin(), sorted.end(), [](const Named& a, const Named& b) { return a.section < b.section; });
+
+    vector<SectionOperation> result;
+    for (size_t begin = 0; begin < sorted.size();)
+    {
+        size_t end = begin;
+        while (end < sorted.size() && sorted[end].section == sorted[begin].section)
+            end++;
+
+        SectionOperation sectionOperation;
+        sectionOperation.section = std::move(sorted[begin].section);
+
+        // una deleteSection annulla tutto quello che la precede nella stessa sezione
+        size_t first = begin;
+        for (size_t i = begin; i < end; i++)
+        {
+            if (sorted[i].operation->type == Type::DeleteSection)
+            {
+                sectionOperation.replace = true;
+                first = i + 1;
+            }
+        }
+
+        auto keyOperations = sorted.begin() + static_cast<ptrdiff_t>(first);
+        auto keyEnd = sorted.begin() + static_cast<ptrdiff_t>(end);
+        stable_sort(keyOperations, keyEnd, [](const Named& a, const Named& b) { return a.key < b.key; });
+
+        for (auto it = keyOperations; it != keyEnd; ++it)
+        {
+            if (it + 1 != keyEnd && (it + 1)->key == it->key)
+                continue;   // vince l'ultima operazione sulla stessa chiave
+
+            bool erase = it->operation->type == Type::DeleteKey;
+            if (erase && sectionOperation.replace)
+                continue;   // la sezione e' gia' vuota
+
+            sectionOperation.keys.push_back({std::move(it->key), erase, &it->operation->value});
+        }
+
+        if (sectionOperation.replace && sectionOperation.keys.empty())
+        {
+            sectionOperation.replace = false;
+            sectionOperation.eraseSection = true;
+        }
+
+        result.push_back(std::move(sectionOperation));
+        begin = end;
+    }
+
+    return result;
+}
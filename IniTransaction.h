@@ -0,0 +1,359 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_INITRANSACTION_H
+#define INIMANAGER_INITRANSACTION_H
+
+#include "IniFile.h"
+
+// Raccoglie set e cancellazioni da applicare in blocco con BasicIniFile::commit: le operazioni vengono
+// ordinate per sezione e chiave, tutto cio' che puo' fallire (allocazioni) avviene prima di toccare
+// il file, quindi il commit o riesce per intero o lascia il file com'era.
+class IniTransaction
+{
+    public:
+        IniTransaction& set(const string& section, const string& key, const string& value);
+        IniTransaction& deleteKey(const string& section, const string& key);
+        IniTransaction& deleteSection(const string& section);
+        size_t size() const;
+        bool empty() const;
+        void clear();
+
+    private:
+        template <typename, typename, typename, typename, typename> friend class BasicIniFile;
+        friend class ConcurrentIniFile;
+        friend class VersionedIniFile;
+
+        enum class Type { Set, DeleteKey, DeleteSection };
+
+        using Fold = void (*)(string& name);
+
+        struct Operation
+        {
+            Type type;
+            string section;     // come passati dal chiamante: li normalizza plan() con le regole del file
+            string key;
+            string value;
+        };
+
+        struct KeyOperation
+        {
+            string key;
+            bool erase;
+            const string* value;    // punta alla stringa di operations, senza copiarla
+        };
+
+        struct SectionOperation
+        {
+            string section;
+            bool eraseSection = false;  // la sezione sparisce
+            bool replace = false;       // la sezione viene svuotata prima di applicare le chiavi
+            vector<KeyOperation> keys;  // ordinate, al piu' una per chiave
+        };
+
+        // modifiche a una sezione gia' esistente in una mappa ordinata a nodi, preparate in anticipo e
+        // applicate senza eccezioni
+        template <typename KeyMap>
+        class PreparedKeys
+        {
+            public:
+                PreparedKeys(KeyMap& target, const SectionOperation& operation, vector<IniChange>* changes);
+                void apply() noexcept;
+
+            private:
+                using String = typename KeyMap::mapped_type;
+
+                struct Step
+                {
+                    typename KeyMap::iterator position;
+                    typename KeyMap::node_type node;
+                    String value;       // con l'allocatore di target: lo scambio non copia
+                    enum { Assign, Insert, Erase } kind;
+                };
+
+                KeyMap* target;
+                vector<Step> steps;
+        };
+
+        vector<Operation> operations;
+
+        vector<SectionOperation> plan(Fold fold = &IniCaseInsensitive::fold<string>) const;
+        template <typename KeyMap>
+        static KeyMap buildSection(const SectionOperation& operation, const KeyMap* previous, vector<IniChange>* changes,
+                                   const typename KeyMap::allocator_type& allocator);
+};
+
+template <typename KeyMap>
+KeyMap IniTransaction::buildSection(const SectionOperation& operation, const KeyMap* previous, vector<IniChange>* changes,
+                                    const typename KeyMap::allocator_type& allocator)
+{
+    using String = typename KeyMap::key_type;
+
+    KeyMap keys(allocator);
+    for (const auto& key : operation.keys)
+    {
+        if (!key.erase)
+            keys.insert_or_assign(String(key.key, allocator), *key.value);
+    }
+
+    if (changes != nullptr)
+    {
+        // stesso risultato di diff sulla sola sezione: modifiche ordinate per chiave
+        size_t first = changes->size();
+        if (previous != nullptr)
+        {
+            for (const auto& key : *previous)
+            {
+                if (keys.find(key.first) == keys.end())
+                    changes->push_back({IniChange::Type::Removed, operation.section, key.first, key.second, ""});
+            }
+        }
+        for (const auto& key : keys)
+        {
+            auto old = previous != nullptr ? previous->find(key.first) : typename KeyMap::const_iterator();
+            if (previous == nullptr || old == previous->end())
+                changes->push_back({IniChange::Type::Added, operation.section, key.first, "", key.second});
+            else if (old->second != key.second)
+                changes->push_back({IniChange::Type::Modified, operation.section, key.first, old->second, key.second});
+        }
+        sort(changes->begin() + static_cast<ptrdiff_t>(first), changes->end(),
+             [](const IniChange& a, const IniChange& b) { return a.key < b.key; });
+    }
+
+    return keys;
+}
+
+template <typename KeyMap>
+IniTransaction::PreparedKeys<KeyMap>::PreparedKeys(KeyMap& target, const SectionOperation& operation,
+                                                   vector<IniChange>* changes)
+    : target(&target)
+{
+    steps.reserve(operation.keys.size());
+
+    // con molte operazioni rispetto alla dimensione della sezione conviene un'unica passata di merge,
+    // altrimenti una ricerca per chiave
+    bool merge = operation.keys.size() * 8 >= target.size();
+    auto position = target.begin();
+
+    for (const auto& key : operation.keys)
+    {
+        if (merge)
+        {
+            while (position != target.end() && string_view(position->first) < key.key)
+                ++position;
+        }
+        else
+        {
+            position = target.lower_bound(key.key);
+        }
+
+        bool exists = position != target.end() && string_view(position->first) == key.key;
+
+        if (key.erase)
+        {
+            if (!exists)
+                continue;
+
+            if (changes != nullptr)
+                changes->push_back({IniChange::Type::Removed, operation.section, key.key, position->second, ""});
+            steps.push_back({position, {}, String(target.get_allocator()), Step::Erase});
+        }
+        else if (exists)
+        {
+            if (string_view(position->second) == *key.value)
+                continue;
+
+            if (changes != nullptr)
+                changes->push_back({IniChange::Type::Modified, operation.section, key.key, position->second, *key.value});
+            steps.push_back({position, {}, String(*key.value, target.get_allocator()), Step::Assign});
+        }
+        else
+        {
+            // il nodo viene allocato adesso, l'inserimento vero e proprio non alloca piu' nulla
+            KeyMap node(target.get_allocator());     // un nodo si inserisce solo in una mappa con lo stesso allocatore
+            node.emplace(key.key, *key.value);
+
+            if (changes != nullptr)
+                changes->push_back({IniChange::Type::Added, operation.section, key.key, "", *key.value});
+            steps.push_back({position, node.extract(node.begin()), String(target.get_allocator()), Step::Insert});
+        }
+    }
+}
+
+template <typename KeyMap>
+void IniTransaction::PreparedKeys<KeyMap>::apply() noexcept
+{
+    // i passi sono in ordine di chiave: il suggerimento di ogni inserimento punta a una chiave successiva,
+    // che non e' ancora stata toccata
+    for (auto& step : steps)
+    {
+        switch (step.kind)
+        {
+            case Step::Assign:
+                step.position->second.swap(step.value);
+                break;
+            case Step::Insert:
+                target->insert(step.position, std::move(step.node));
+                break;
+            case Step::Erase:
+                target->erase(step.position);
+                break;
+        }
+    }
+}
+
+template <typename CasePolicy, typename CommentPolicy, typename StoragePolicy, typename LockingPolicy, typename Allocator>
+void BasicIniFile<CasePolicy, CommentPolicy, StoragePolicy, LockingPolicy, Allocator>::commit(const IniTransaction& transaction,
+                                                                                            vector<IniChange>* changes)
+{
+    vector<IniTransaction::SectionOperation> plan = transaction.plan(&CasePolicy::template fold<string>);
+    unique_lock<Mutex> lock(mutex);
+
+    if constexpr (is_same_v<StoragePolicy, IniOrderedStorage>)
+    {
+        // fase 1: tutto cio' che alloca, senza modificare il file
+        Sections newSections(data.get_allocator());     // stesso allocatore di data: i nodi vengono spostati senza copie
+        vector<pair<Section*, Section>> replacements;
+        vector<IniTransaction::PreparedKeys<Keys>> prepared;
+        vector<typename Sections::iterator> erased;
+
+        for (const auto& operation : plan)
+        {
+            auto it = data.find(operation.section);
+
+            if (operation.eraseSection)
+            {
+                if (it == data.end())
+                    continue;
+
+                if (changes != nullptr)
+                {
+                    for (const auto& key : it->second)
+                        changes->push_back({IniChange::Type::Removed, operation.section, key.first, key.second, ""});
+                }
+                erased.push_back(it);
+            }
+            else if (it == data.end())
+            {
+                auto keys = IniTransaction::buildSection<Keys>(operation, nullptr, changes, data.get_allocator());
+                if (!keys.empty())
+                    newSections.emplace_hint(newSections.end(), operation.section, std::move(keys));
+            }
+            else if (operation.replace)
+            {
+                replacements.emplace_back(&it->second,
+                                          Section(IniTransaction::buildSection<Keys>(operation, &it->second.keys(), changes,
+                                                                                     data.get_allocator()),
+                                                  get_allocator()));
+            }
+            else
+            {
+                prepared.emplace_back(it->second.edit(), operation, changes);  // se condivisa la sezione si clona qui
+            }
+        }
+
+        // fase 2: solo operazioni che non possono fallire
+        for (auto& keys : prepared)
+            keys.apply();
+        for (auto& replacement : replacements)
+            *replacement.first = std::move(replacement.second);     // stesso allocatore: si sposta il puntatore
+        for (auto& it : erased)
+            data.erase(it);
+        while (!newSections.empty())
+            data.insert(newSections.extract(newSections.begin()));
+    }
+    else
+    {
+        // contenitori senza nodi da spostare: le modifiche vanno su una copia che alla fine si scambia con data.
+        // Le sezioni sono copy-on-write, quindi la copia costa quanto il numero di sezioni, non di chiavi.
+        Sections next(data, data.get_allocator());
+        for (const auto& operation : plan)
+        {
+            String name(operation.section, get_allocator());
+            auto it = next.find(name);
+
+            if (operation.eraseSection)
+            {
+                if (it == next.end())
+                    continue;
+
+                if (changes != nullptr)
+                {
+                    size_t first = changes->size();
+                    for (const auto& key : it->second)
+                        changes->push_back({IniChange::Type::Removed, operation.section, key.first, key.second, ""});
+                    if (!StoragePolicy::inOrder(it->second.keys()))
+                    {
+                        sort(changes->begin() + static_cast<ptrdiff_t>(first), changes->end(),
+                             [](const IniChange& a, const IniChange& b) { return a.key < b.key; });
+                    }
+                }
+                next.erase(it);
+            }
+            else if (it == next.end() || operation.replace)
+            {
+                const Keys* previous = it != next.end() ? &it->second.keys() : nullptr;
+                Keys keys = IniTransaction::buildSection<Keys>(operation, previous, changes, data.get_allocator());
+                StoragePolicy::restoreOrder(keys);
+                if (it != next.end())
+                    it->second = Section(std::move(keys), get_allocator());
+                else if (!keys.empty())
+                    next.try_emplace(name).first->second = Section(std::move(keys), get_allocator());
+            }
+            else
+            {
+                Keys& keys = it->second.edit();
+                for (const auto& key : operation.keys)
+                {
+                    String keyName(key.key, get_allocator());
+                    auto position = keys.find(keyName);
+                    if (key.erase)
+                    {
+                        if (position == keys.end())
+                            continue;
+                        if (changes != nullptr)
+                            changes->push_back({IniChange::Type::Removed, operation.section, key.key, position->second, ""});
+                        keys.erase(position);
+                    }
+                    else if (position == keys.end())
+                    {
+                        if (changes != nullptr)
+                            changes->push_back({IniChange::Type::Added, operation.section, key.key, "", *key.value});
+                        keys.insert_or_assign(std::move(keyName), *key.value);
+                    }
+                    else if (string_view(position->second) != *key.value)
+                    {
+                        if (changes != nullptr)
+                            changes->push_back({IniChange::Type::Modified, operation.section, key.key, position->second,
+                                                *key.value});
+                        position->second = *key.value;
+                    }
+                }
+                StoragePolicy::restoreOrder(keys);      // una volta per sezione, non a ogni chiave
+            }
+        }
+        StoragePolicy::restoreOrder(next);
+        data.swap(next);
+    }
+
+    for (const auto& operation : plan)
+    {
+        if (operation.eraseSection || operation.replace)
+            interpolator.invalidateSection(operation.section);
+        for (const auto& key : operation.keys)
+            interpolator.invalidate(operation.section, key.key);
+    }
+
+#if INIMANAGER_STATS
+    for (const auto& operation : plan)
+    {
+        if (operation.eraseSection)
+            IniStatsCounters::add(counters.deletes);
+        for (const auto& key : operation.keys)
+            IniStatsCounters::add(key.erase ? counters.deletes : counters.sets);
+    }
+#endif
+}
+
+#endif //INIMANAGER_INITRANSACTION_H
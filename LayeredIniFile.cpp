@@ -0,0 +1,269 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "LayeredIniFile.h"
+#include <set>
+
+void LayeredIniFile::addLayer(const string& name, IniFile layer)
+{
+    for (const auto& existing : layers)
+    {
+        if (existing->name == name)
+            throw invalid_argument("Duplicate layer: " + name);
+    }
+
+    layers.push_back(make_unique<Layer>(Layer{name, std::move(layer)}));
+    size_t top = layers.size() - 1;
+
+    // il nuovo livello ha la precedenza su tutti gli altri: ogni sua chiave sovrascrive l'indice
+    for (const auto& section : layers.back()->file.data)
+    {
+        sectionLayers[string(section.first)]++;
+        for (const auto& key : section.second)
+            index[indexKey(section.first, key.first)] = {top, &key.second};
+    }
+}
+
+void LayeredIniFile::replaceLayer(const string& name, IniFile layer)
+{
+    // il file esistente viene aggiornato con le sole differenze: i nodi delle chiavi invariate
+    // restano dove sono e le voci dell'indice che li puntano restano valide
+    size_t replaced = layerIndex(name);
+    IniFile& current = layers[replaced]->file;
+    current.materializeComments();      // i commenti vengono sostituiti in blocco qui sotto
+    layer.materializeComments();
+
+    std::set<string> sections;     // qualificato: "set" qui e' il metodo di LayeredIniFile
+    for (const auto& section : current.data)
+        sections.emplace(section.first);
+    for (const auto& section : layer.data)
+        sections.emplace(section.first);
+
+    for (const auto& change : IniFile::diff(current, layer))
+    {
+        if (change.type == IniChange::Type::Removed)
+            current.deleteKey(change.section, change.key);
+        else
+            current.set(change.section, change.key, change.newValue);
+        refreshKey(change.section, change.key);
+    }
+
+    for (const auto& section : sections)
+    {
+        if (layer.data.count(section) > 0)
+            current.addSection(section);
+        else
+            current.deleteSection(section);     // ormai vuota: le chiavi sono state rimosse sopra
+        refreshSection(section);
+        rebindSection(replaced, section);       // le modifiche sopra possono aver clonato la sezione
+    }
+
+    current.fileName = std::move(layer.fileName);
+    current.sectionComments = std::move(layer.sectionComments);
+    current.keyComments = std::move(layer.keyComments);
+}
+
+const IniFile& LayeredIniFile::layer(const string& name) const
+{
+    return layers[layerIndex(name)]->file;
+}
+
+size_t LayeredIniFile::layerCount() const
+{
+    return layers.size();
+}
+
+string LayeredIniFile::get(const string& section, const string& key) const
+{
+    const Entry* entry = find(section, key);
+    return entry != nullptr ? string(*entry->value) : "";
+}
+
+string_view LayeredIniFile::getView(const string& section, const string& key) const
+{
+    const Entry* entry = find(section, key);
+    return entry != nullptr ? string_view(*entry->value) : string_view();
+}
+
+string LayeredIniFile::layerOf(const string& section, const string& key) const
+{
+    const Entry* entry = find(section, key);
+    return entry != nullptr ? layers[entry->layer]->name : "";
+}
+
+bool LayeredIniFile::hasSection(const string& section) const
+{
+    return sectionLayers.find(IniFile::foldForLookup(section)) != sectionLayers.end();
+}
+
+bool LayeredIniFile::hasKey(const string& section, const string& key) const
+{
+    return find(section, key) != nullptr;
+}
+
+void LayeredIniFile::set(const string& layer, const string& section, const string& key, const string& value)
+{
+    size_t i = layerIndex(layer);
+    string lowerSection = IniFile::toLower(section);
+    const IniFile::Keys* before = sectionKeys(i, lowerSection);
+
+    layers[i]->file.set(section, key, value);
+    if (before != nullptr && sectionKeys(i, lowerSection) != before)
+        rebindSection(i, lowerSection);
+    refreshKey(lowerSection, IniFile::toLower(key));
+    refreshSection(lowerSection);
+}
+
+bool LayeredIniFile::deleteKey(const string& layer, const string& section, const string& key)
+{
+    size_t i = layerIndex(layer);
+    string lowerSection = IniFile::toLower(section);
+    const IniFile::Keys* before = sectionKeys(i, lowerSection);
+
+    if (!layers[i]->file.deleteKey(section, key))
+        return false;
+
+    if (sectionKeys(i, lowerSection) != before)
+        rebindSection(i, lowerSection);
+    refreshKey(lowerSection, IniFile::toLower(key));
+    return true;
+}
+
+bool LayeredIniFile::deleteSection(const string& layer, const string& section)
+{
+    IniFile& file = layers[layerIndex(layer)]->file;
+    string lowerSection = IniFile::toLower(section);
+    auto it = file.data.find(lowerSection);
+    if (it == file.data.end())
+        return false;
+
+    vector<string> keys;
+    keys.reserve(it->second.size());
+    for (const auto& key : it->second)
+        keys.emplace_back(key.first);
+
+    file.deleteSection(lowerSection);
+    for (const auto& key : keys)
+        refreshKey(lowerSection, key);
+    refreshSection(lowerSection);
+    return true;
+}
+
+IniFile LayeredIniFile::flatten() const
+{
+    IniFile merged;
+    for (const auto& layer : layers)
+    {
+        layer->file.materializeComments();
+        for (const auto& section : layer->file.data)
+        {
+            auto& keys = merged.data[section.first];
+            if (keys.empty())
+            {
+                keys = section.second;      // sezione presa da un solo livello: condivisa, non copiata
+                continue;
+            }
+            auto& mergedKeys = keys.edit();
+            for (const auto& key : section.second)
+                mergedKeys.insert_or_assign(key.first, key.second);
+        }
+        for (const auto& comment : layer->file.sectionComments)
+            merged.sectionComments.insert_or_assign(comment.first, comment.second);
+        for (const auto& section : layer->file.keyComments)
+        {
+            auto& mergedComments = merged.keyComments[section.first].edit();
+            for (const auto& comment : section.second)
+                mergedComments.insert_or_assign(comment.first, comment.second);
+        }
+    }
+
+    return merged;
+}
+
+size_t LayeredIniFile::layerIndex(const string& name) const
+{
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i]->name == name)
+            return i;
+    }
+
+    throw out_of_range("No such layer: " + name);
+}
+
+const LayeredIniFile::Entry* LayeredIniFile::find(const string& section, const string& key) const
+{
+    // chiave composta in un buffer per thread, come in IniFile: nessuna allocazione a regime
+    thread_local string lookup;
+    lookup.assign(section).append(1, '\0').append(key);
+    transform(lookup.begin(), lookup.end(), lookup.begin(), ::tolower);
+
+    auto it = index.find(lookup);
+    return it != index.end() ? &it->second : nullptr;
+}
+
+string LayeredIniFile::indexKey(string_view section, string_view key)
+{
+    string result;
+    result.reserve(section.size() + key.size() + 1);
+    result.append(section).append(1, '\0').append(key);
+    return result;
+}
+
+const IniFile::Keys* LayeredIniFile::sectionKeys(size_t layer, const string& section) const
+{
+    const auto& data = layers[layer]->file.data;
+    auto it = data.find(section);
+    return it != data.end() ? &it->second.keys() : nullptr;
+}
+
+void LayeredIniFile::refreshKey(const string& section, const string& key)
+{
+    // il livello piu' alto che contiene ancora la chiave fornisce il valore
+    for (size_t i = layers.size(); i-- > 0;)
+    {
+        const auto& data = layers[i]->file.data;
+        auto sectionIt = data.find(section);
+        if (sectionIt == data.end())
+            continue;
+
+        auto keyIt = sectionIt->second.find(key);
+        if (keyIt != sectionIt->second.end())
+        {
+            index[indexKey(section, key)] = {i, &keyIt->second};
+            return;
+        }
+    }
+
+    index.erase(indexKey(section, key));
+}
+
+void LayeredIniFile::refreshSection(const string& section)
+{
+    size_t count = 0;
+    for (const auto& layer : layers)
+        count += layer->file.data.count(section);
+
+    if (count > 0)
+        sectionLayers[section] = count;
+    else
+        sectionLayers.erase(section);
+}
+
+void LayeredIniFile::rebindSection(size_t layer, const string& section)
+{
+    // le sezioni sono copy-on-write: se il livello condivideva la sezione con una copia (quella passata ad
+    // addLayer, una copia di layer() o flatten()) la modifica l'ha clonata, e le voci che puntano alle
+    // altre chiavi del livello devono passare ai nodi della nuova mappa
+    const IniFile::Keys* keys = sectionKeys(layer, section);
+    if (keys == nullptr)
+        return;
+
+    for (const auto& key : *keys)
+    {
+        auto entry = index.find(indexKey(section, key.first));
+        if (entry != index.end() && entry->second.layer == layer)
+            entry->second.value = &key.second;
+    }
+}
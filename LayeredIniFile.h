@@ -0,0 +1,70 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_LAYEREDINIFILE_H
+#define INIMANAGER_LAYEREDINIFILE_H
+
+#include <memory>
+#include <unordered_map>
+#include "IniFile.h"
+
+using namespace std;
+
+// Pila di IniFile in ordine di precedenza: l'ultimo livello aggiunto vince. Un indice appiattito
+// (sezione + chiave -> livello e valore) risponde a ogni ricerca con un solo accesso, qualunque sia
+// il numero di livelli. Le modifiche passano da qui, cosi' l'indice viene aggiornato solo per le
+// chiavi toccate.
+class LayeredIniFile
+{
+    public:
+        LayeredIniFile() = default;
+        LayeredIniFile(const LayeredIniFile&) = delete;
+        LayeredIniFile& operator=(const LayeredIniFile&) = delete;
+        LayeredIniFile(LayeredIniFile&&) = default;
+        LayeredIniFile& operator=(LayeredIniFile&&) = default;
+
+        void addLayer(const string& name, IniFile layer);
+        void replaceLayer(const string& name, IniFile layer);
+        const IniFile& layer(const string& name) const;
+        size_t layerCount() const;
+
+        string get(const string& section, const string& key) const;
+        string_view getView(const string& section, const string& key) const;
+        string layerOf(const string& section, const string& key) const;
+        bool hasSection(const string& section) const;
+        bool hasKey(const string& section, const string& key) const;
+
+        void set(const string& layer, const string& section, const string& key, const string& value);
+        bool deleteKey(const string& layer, const string& section, const string& key);
+        bool deleteSection(const string& layer, const string& section);
+
+        IniFile flatten() const;
+
+    private:
+        struct Layer
+        {
+            string name;
+            IniFile file;
+        };
+
+        struct Entry
+        {
+            size_t layer;
+            const IniFile::String* value;   // punta al nodo della mappa nel livello, stabile finche' la sezione non viene clonata
+        };
+
+        vector<unique_ptr<Layer>> layers;
+        unordered_map<string, Entry> index;             // chiave: sezione + '\0' + chiave, in minuscolo
+        unordered_map<string, size_t> sectionLayers;    // in quanti livelli compare ogni sezione
+
+        size_t layerIndex(const string& name) const;
+        const Entry* find(const string& section, const string& key) const;
+        static string indexKey(string_view section, string_view key);
+        const IniFile::Keys* sectionKeys(size_t layer, const string& section) const;
+        void refreshKey(const string& section, const string& key);
+        void refreshSection(const string& section);
+        void rebindSection(size_t layer, const string& section);
+};
+
+#endif //INIMANAGER_LAYEREDINIFILE_H
@@ -0,0 +1,339 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "SharedIniSegment.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(atomic<uint64_t>::is_always_lock_free, "shared memory atomics must be lock-free");
+static_assert(atomic<uint32_t>::is_always_lock_free, "shared memory atomics must be lock-free");
+
+// confronta un nome salvato (gia' minuscolo) con quello cercato, senza allocare
+static int compareFolded(const unsigned char* stored, uint32_t storedLength, const string& wanted)
+{
+    size_t length = min<size_t>(storedLength, wanted.size());
+    for (size_t i = 0; i < length; i++)
+    {
+        int a = stored[i];
+        int b = tolower(static_cast<unsigned char>(wanted[i]));
+        if (a != b)
+            return a < b ? -1 : 1;
+    }
+
+    if (storedLength == wanted.size())
+        return 0;
+    return storedLength < wanted.size() ? -1 : 1;
+}
+
+SharedIniSegment SharedIniSegment::create(const string& name, size_t capacity)
+{
+    if (capacity > UINT32_MAX)
+        throw runtime_error("Shared INI segment capacity too large: " + to_string(capacity));
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+        throw runtime_error("Unable to create shared memory segment: " + name);
+
+    size_t size = headerSize + 2 * capacity;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        close(fd);
+        throw runtime_error("Unable to resize shared memory segment: " + name);
+    }
+
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        throw runtime_error("Unable to map shared memory segment: " + name);
+
+    auto* header = new (mapped) Header;
+    header->magic = segmentMagic;
+    header->layoutVersion = segmentLayoutVersion;
+    header->reserved = 0;
+    header->bufferCapacity = capacity;
+    header->generation.store(0, memory_order_relaxed);
+    header->active.store(0, memory_order_relaxed);
+    for (auto& state : header->buffers)
+    {
+        state.sequence.store(0, memory_order_relaxed);
+        state.used = 0;
+    }
+
+    return SharedIniSegment(static_cast<unsigned char*>(mapped), size, true);
+}
+
+SharedIniSegment SharedIniSegment::attach(const string& name)
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        throw runtime_error("Unable to open shared memory segment: " + name);
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < headerSize)
+    {
+        close(fd);
+        throw runtime_error("Invalid shared memory segment: " + name);
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        throw runtime_error("Unable to map shared memory segment: " + name);
+
+    SharedIniSegment segment(static_cast<unsigned char*>(mapped), size, false);
+    const Header* header = segment.header();
+    if (header->magic != segmentMagic || header->layoutVersion != segmentLayoutVersion
+        || headerSize + 2 * header->bufferCapacity > size)
+        throw runtime_error("Invalid shared memory segment: " + name);
+
+    return segment;
+}
+
+bool SharedIniSegment::remove(const string& name)
+{
+    return shm_unlink(name.c_str()) == 0;
+}
+
+size_t SharedIniSegment::requiredSize(const IniFile& ini)
+{
+    size_t size = 2 * sizeof(uint32_t);
+    for (const auto& section : ini.data)
+    {
+        size += sizeof(SectionEntry) + section.first.size();
+        for (const auto& key : section.second)
+            size += sizeof(KeyEntry) + key.first.size() + key.second.size();
+    }
+
+    return size;
+}
+
+SharedIniSegment::SharedIniSegment(unsigned char* base, size_t mappedSize, bool writable)
+    : base(base), mappedSize(mappedSize), writable(writable)
+{
+}
+
+SharedIniSegment::SharedIniSegment(SharedIniSegment&& other) noexcept
+    : base(other.base), mappedSize(other.mappedSize), writable(other.writable)
+{
+    other.base = nullptr;
+    other.mappedSize = 0;
+}
+
+SharedIniSegment& SharedIniSegment::operator=(SharedIniSegment&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (base != nullptr)
+            munmap(base, mappedSize);
+        base = other.base;
+        mappedSize = other.mappedSize;
+        writable = other.writable;
+        other.base = nullptr;
+        other.mappedSize = 0;
+    }
+    return *this;
+}
+
+SharedIniSegment::~SharedIniSegment()
+{
+    if (base != nullptr)
+        munmap(base, mappedSize);
+}
+
+void SharedIniSegment::publish(const IniFile& ini)
+{
+    if (!writable)
+        throw runtime_error("Shared memory segment is read-only");
+
+    size_t size = requiredSize(ini);
+    if (size > capacity())
+        throw runtime_error("Shared memory segment too small: " + to_string(size) + " bytes needed");
+
+    Header* h = header();
+    uint32_t target = 1 - h->active.load(memory_order_relaxed);
+    BufferState& state = h->buffers[target];
+
+    uint64_t sequence = state.sequence.load(memory_order_relaxed);
+    state.sequence.store(sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    unsigned char* out = buffer(target);
+    uint32_t sectionCount = static_cast<uint32_t>(ini.data.size());
+    uint32_t keyCount = 0;
+    for (const auto& section : ini.data)
+        keyCount += static_cast<uint32_t>(section.second.size());
+
+    memcpy(out, &sectionCount, sizeof(sectionCount));
+    memcpy(out + sizeof(uint32_t), &keyCount, sizeof(keyCount));
+
+    size_t sectionTable = 2 * sizeof(uint32_t);
+    size_t keyTable = sectionTable + sectionCount * sizeof(SectionEntry);
+    size_t blob = keyTable + keyCount * sizeof(KeyEntry);
+
+    auto appendString = [out, &blob](string_view str)
+    {
+        memcpy(out + blob, str.data(), str.size());
+        auto offset = static_cast<uint32_t>(blob);
+        blob += str.size();
+        return offset;
+    };
+
+    uint32_t keyIndex = 0;
+    for (const auto& section : ini.data)
+    {
+        SectionEntry sectionEntry{appendString(section.first), static_cast<uint32_t>(section.first.size()),
+                                  keyIndex, static_cast<uint32_t>(section.second.size())};
+        memcpy(out + sectionTable, &sectionEntry, sizeof(sectionEntry));
+        sectionTable += sizeof(SectionEntry);
+
+        for (const auto& key : section.second)
+        {
+            KeyEntry keyEntry{appendString(key.first), static_cast<uint32_t>(key.first.size()), 0, static_cast<uint32_t>(key.second.size())};
+            keyEntry.valueOffset = appendString(key.second);
+            memcpy(out + keyTable + keyIndex * sizeof(KeyEntry), &keyEntry, sizeof(keyEntry));
+            keyIndex++;
+        }
+    }
+
+    state.used = size;
+    state.sequence.store(sequence + 2, memory_order_release);
+    h->active.store(target, memory_order_release);
+    h->generation.fetch_add(1, memory_order_release);
+}
+
+string SharedIniSegment::get(const string& section, const string& key) const
+{
+    string value;
+    if (lookup(section, key, &value) != Lookup::Found)
+        return "";
+
+    return value;
+}
+
+bool SharedIniSegment::hasSection(const string& section) const
+{
+    return lookup(section, "", nullptr) != Lookup::MissingSection;
+}
+
+bool SharedIniSegment::hasKey(const string& section, const string& key) const
+{
+    return lookup(section, key, nullptr) == Lookup::Found;
+}
+
+uint64_t SharedIniSegment::generation() const
+{
+    return header()->generation.load(memory_order_acquire);
+}
+
+size_t SharedIniSegment::capacity() const
+{
+    return header()->bufferCapacity;
+}
+
+SharedIniSegment::Header* SharedIniSegment::header() const
+{
+    return reinterpret_cast<Header*>(base);
+}
+
+unsigned char* SharedIniSegment::buffer(uint32_t index) const
+{
+    return base + headerSize + index * header()->bufferCapacity;
+}
+
+SharedIniSegment::Lookup SharedIniSegment::lookup(const string& section, const string& key, string* value) const
+{
+    const Header* h = header();
+    while (true)
+    {
+        uint32_t index = h->active.load(memory_order_acquire) & 1;
+        const BufferState& state = h->buffers[index];
+
+        uint64_t before = state.sequence.load(memory_order_acquire);
+        if (before & 1)
+            continue;   // il buffer e' in scrittura: si riprova
+
+        uint64_t used = min<uint64_t>(state.used, h->bufferCapacity);
+        Lookup result = lookupIn(buffer(index), used, section, key, value);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (state.sequence.load(memory_order_relaxed) == before)
+            return result;
+    }
+}
+
+SharedIniSegment::Lookup SharedIniSegment::lookupIn(const unsigned char* buffer, uint64_t used, const string& section,
+                                                    const string& key, string* value)
+{
+    // durante una scrittura concorrente i dati possono essere incoerenti: ogni offset viene controllato
+    if (used < 2 * sizeof(uint32_t))
+        return Lookup::MissingSection;
+
+    uint32_t sectionCount, keyCount;
+    memcpy(&sectionCount, buffer, sizeof(sectionCount));
+    memcpy(&keyCount, buffer + sizeof(uint32_t), sizeof(keyCount));
+
+    uint64_t sectionTable = 2 * sizeof(uint32_t);
+    uint64_t keyTable = sectionTable + uint64_t(sectionCount) * sizeof(SectionEntry);
+    if (keyTable + uint64_t(keyCount) * sizeof(KeyEntry) > used)
+        return Lookup::MissingSection;
+
+    auto inBounds = [used](uint32_t offset, uint32_t length) { return uint64_t(offset) + length <= used; };
+
+    uint32_t low = 0, high = sectionCount;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        SectionEntry entry{};
+        memcpy(&entry, buffer + sectionTable + middle * sizeof(SectionEntry), sizeof(entry));
+        if (!inBounds(entry.nameOffset, entry.nameLength))
+            return Lookup::MissingSection;
+
+        int cmp = compareFolded(buffer + entry.nameOffset, entry.nameLength, section);
+        if (cmp < 0)
+        {
+            low = middle + 1;
+            continue;
+        }
+        if (cmp > 0)
+        {
+            high = middle;
+            continue;
+        }
+
+        if (value == nullptr && key.empty())
+            return Lookup::MissingKey;  // basta sapere che la sezione esiste
+        if (uint64_t(entry.firstKey) + entry.keyCount > keyCount)
+            return Lookup::MissingSection;
+
+        uint32_t keyLow = entry.firstKey, keyHigh = entry.firstKey + entry.keyCount;
+        while (keyLow < keyHigh)
+        {
+            uint32_t keyMiddle = keyLow + (keyHigh - keyLow) / 2;
+            KeyEntry keyEntry{};
+            memcpy(&keyEntry, buffer + keyTable + keyMiddle * sizeof(KeyEntry), sizeof(keyEntry));
+            if (!inBounds(keyEntry.nameOffset, keyEntry.nameLength) || !inBounds(keyEntry.valueOffset, keyEntry.valueLength))
+                return Lookup::MissingKey;
+
+            int keyCmp = compareFolded(buffer + keyEntry.nameOffset, keyEntry.nameLength, key);
+            if (keyCmp < 0)
+                keyLow = keyMiddle + 1;
+            else if (keyCmp > 0)
+                keyHigh = keyMiddle;
+            else
+            {
+                if (value != nullptr)
+                    value->assign(reinterpret_cast<const char*>(buffer + keyEntry.valueOffset), keyEntry.valueLength);
+                return Lookup::Found;
+            }
+        }
+
+        return Lookup::MissingKey;
+    }
+
+    return Lookup::MissingSection;
+}
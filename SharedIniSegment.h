@@ -0,0 +1,88 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_SHAREDINISEGMENT_H
+#define INIMANAGER_SHAREDINISEGMENT_H
+
+#include <atomic>
+#include <cstdint>
+#include "IniFile.h"
+
+// Segmento di memoria condivisa POSIX con il contenuto di un IniFile gia' parsato.
+// Il layout usa solo offset, quindi ogni processo puo' mapparlo a un indirizzo qualsiasi.
+// Ci sono due buffer: chi pubblica scrive in quello inattivo e poi lo rende attivo,
+// mentre i lettori usano un contatore di sequenza per riconoscere letture incoerenti.
+class SharedIniSegment
+{
+    public:
+        static SharedIniSegment create(const string& name, size_t capacity);
+        static SharedIniSegment attach(const string& name);
+        static bool remove(const string& name);
+        static size_t requiredSize(const IniFile& ini);
+
+        SharedIniSegment(SharedIniSegment&& other) noexcept;
+        SharedIniSegment& operator=(SharedIniSegment&& other) noexcept;
+        SharedIniSegment(const SharedIniSegment&) = delete;
+        SharedIniSegment& operator=(const SharedIniSegment&) = delete;
+        ~SharedIniSegment();
+
+        void publish(const IniFile& ini);
+        string get(const string& section, const string& key) const;
+        bool hasSection(const string& section) const;
+        bool hasKey(const string& section, const string& key) const;
+        uint64_t generation() const;
+        size_t capacity() const;
+
+    private:
+        struct BufferState
+        {
+            atomic<uint64_t> sequence;  // dispari mentre il buffer viene scritto
+            uint64_t used;
+        };
+
+        struct Header
+        {
+            uint64_t magic;
+            uint32_t layoutVersion;
+            uint32_t reserved;
+            uint64_t bufferCapacity;
+            atomic<uint64_t> generation;
+            atomic<uint32_t> active;
+            BufferState buffers[2];
+        };
+
+        struct SectionEntry
+        {
+            uint32_t nameOffset;
+            uint32_t nameLength;
+            uint32_t firstKey;
+            uint32_t keyCount;
+        };
+
+        struct KeyEntry
+        {
+            uint32_t nameOffset;
+            uint32_t nameLength;
+            uint32_t valueOffset;
+            uint32_t valueLength;
+        };
+
+        enum class Lookup { MissingSection, MissingKey, Found };
+
+        static constexpr uint64_t segmentMagic = 0x494e494d53484d31ULL;  // "INIMSHM1"
+        static constexpr uint32_t segmentLayoutVersion = 1;
+        static constexpr size_t headerSize = 128;
+
+        unsigned char* base = nullptr;
+        size_t mappedSize = 0;
+        bool writable = false;
+
+        SharedIniSegment(unsigned char* base, size_t mappedSize, bool writable);
+        Header* header() const;
+        unsigned char* buffer(uint32_t index) const;
+        Lookup lookup(const string& section, const string& key, string* value) const;
+        static Lookup lookupIn(const unsigned char* buffer, uint64_t used, const string& section, const string& key, string* value);
+};
+
+#endif //INIMANAGER_SHAREDINISEGMENT_H
@@ -0,0 +1,376 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#include "VersionedIniFile.h"
+#include <algorithm>
+#include <tuple>
+
+// i commenti delle chiavi che non ci sono piu' se ne vanno con le chiavi
+static void eraseStaleComments(IniSection& keyComments, const IniSection& keys)
+{
+    auto stale = [&keys](const auto& comment) { return keys.count(comment.first) == 0; };
+    if (none_of(keyComments.begin(), keyComments.end(), stale))
+        return;     // nessuna copia dei commenti se sono ancora tutti validi
+
+    IniFile::Keys& comments = keyComments.edit();
+    for (auto it = comments.begin(); it != comments.end();)
+        it = stale(*it) ? comments.erase(it) : next(it);
+}
+
+VersionedIniFile::VersionedIniFile() : VersionedIniFile(IniFile())
+{
+}
+
+VersionedIniFile::VersionedIniFile(const IniFile& initial)
+{
+    auto version = make_shared<Version>();
+    version->number = 1;
+    initial.materializeComments();
+
+    for (const auto& section : initial.data)
+    {
+        auto sectionData = make_shared<SectionData>();
+        sectionData->keys = section.second;
+
+        auto keyComments = initial.keyComments.find(section.first);
+        if (keyComments != initial.keyComments.end())
+            sectionData->keyComments = keyComments->second;
+
+        auto comment = initial.sectionComments.find(section.first);
+        if (comment != initial.sectionComments.end())
+            sectionData->comment = comment->second;
+
+        version->sections.assign(string(section.first), std::move(sectionData));
+    }
+
+    latest = version;
+    history.emplace(version->number, latest);
+}
+
+uint64_t VersionedIniFile::commit(const IniTransaction& transaction)
+{
+    vector<IniTransaction::SectionOperation> plan = transaction.plan();
+
+    lock_guard<mutex> commitLock(commitMutex);
+    shared_ptr<const Version> base;
+    {
+        lock_guard<mutex> lock(versionsMutex);
+        base = latest;
+    }
+
+    // la tabella si copia per radice: le sezioni toccate e il cammino verso di esse vengono clonati,
+    // tutto il resto e' condiviso con la versione precedente
+    auto version = make_shared<Version>();
+    version->number = base->number + 1;
+    version->sections = base->sections;
+
+    for (const auto& operation : plan)
+    {
+        const shared_ptr<const SectionData>* found = version->sections.find(operation.section);
+
+        if (operation.eraseSection)
+        {
+            if (found != nullptr)
+                version->sections.erase(operation.section);
+            continue;
+        }
+
+        if (found == nullptr)
+        {
+            auto sectionData = make_shared<SectionData>();
+            sectionData->keys = IniSection(IniTransaction::buildSection<IniSection::Keys>(operation, nullptr, nullptr,
+                                                                        pmr::get_default_resource()), {});
+            if (!sectionData->keys.empty())
+                version->sections.assign(operation.section, std::move(sectionData));
+            continue;
+        }
+
+        auto sectionData = make_shared<SectionData>(**found);     // copia i puntatori, edit() clona solo le chiavi
+        if (operation.replace)
+        {
+            sectionData->keys = IniSection(IniTransaction::buildSection<IniSection::Keys>(operation, nullptr, nullptr,
+                                                                        pmr::get_default_resource()), {});
+        }
+        else
+        {
+            IniTransaction::PreparedKeys<IniSection::Keys> prepared(sectionData->keys.edit(), operation, nullptr);
+            prepared.apply();
+        }
+        eraseStaleComments(sectionData->keyComments, sectionData->keys);
+        version->sections.assign(operation.section, std::move(sectionData));
+    }
+
+    lock_guard<mutex> lock(versionsMutex);
+    latest = version;
+    history.emplace(version->number, latest);
+    collectGarbage();
+    return version->number;
+}
+
+uint64_t VersionedIniFile::currentVersion() const
+{
+    lock_guard<mutex> lock(versionsMutex);
+    return latest->number;
+}
+
+VersionedIniFile::View VersionedIniFile::pin() const
+{
+    lock_guard<mutex> lock(versionsMutex);
+    return View(latest);
+}
+
+VersionedIniFile::View VersionedIniFile::pin(uint64_t version) const
+{
+    lock_guard<mutex> lock(versionsMutex);
+
+    auto it = history.find(version);
+    shared_ptr<const Version> pinned = it == history.end() ? nullptr : it->second.lock();
+    if (!pinned)
+        throw out_of_range("INI file version " + to_string(version) + " is no longer available");
+
+    return View(pinned);
+}
+
+size_t VersionedIniFile::retainedVersions() const
+{
+    lock_guard<mutex> lock(versionsMutex);
+    collectGarbage();
+    return history.size();
+}
+
+void VersionedIniFile::collectGarbage() const
+{
+    // le versioni vengono liberate dai shared_ptr; qui si rimuovono solo le voci ormai scadute
+    for (auto it = history.begin(); it != history.end();)
+    {
+        if (it->second.expired())
+            it = history.erase(it);
+        else
+            ++it;
+    }
+}
+
+VersionedIniFile::View::View(shared_ptr<const Version> version) : pinned(std::move(version))
+{
+}
+
+uint64_t VersionedIniFile::View::version() const
+{
+    return pinned->number;
+}
+
+string VersionedIniFile::View::get(const string& section, const string& key) const
+{
+    const SectionData* found = findSection(section);
+    if (found == nullptr)
+        return "";
+
+    auto it = found->keys.find(IniFile::toLower(key));
+    if (it == found->keys.end())
+        return "";
+
+    return string(it->second);
+}
+
+bool VersionedIniFile::View::hasSection(const string& section) const
+{
+    return findSection(section) != nullptr;
+}
+
+bool VersionedIniFile::View::hasKey(const string& section, const string& key) const
+{
+    const SectionData* found = findSection(section);
+    return found != nullptr && found->keys.find(IniFile::toLower(key)) != found->keys.end();
+}
+
+vector<string> VersionedIniFile::View::hasKey(const string& key) const
+{
+    string lowerKey = IniFile::toLower(key);
+
+    vector<string> sections;
+    pinned->sections.forEach([&sections, &lowerKey](const string& name, const shared_ptr<const SectionData>& section)
+    {
+        if (section->keys.find(lowerKey) != section->keys.end())
+            sections.push_back(name);
+    });
+
+    return sections;
+}
+
+string VersionedIniFile::View::getSectionComment(const string& section) const
+{
+    const SectionData* found = findSection(section);
+    return found == nullptr ? "" : found->comment;
+}
+
+string VersionedIniFile::View::getKeyComment(const string& section, const string& key) const
+{
+    const SectionData* found = findSection(section);
+    if (found == nullptr)
+        return "";
+
+    auto it = found->keyComments.find(IniFile::toLower(key));
+    if (it == found->keyComments.end())
+        return "";
+
+    return string(it->second);
+}
+
+size_t VersionedIniFile::View::sharedSections(const View& other) const
+{
+    size_t shared = 0;
+    pinned->sections.forEach([&shared, &other](const string& name, const shared_ptr<const SectionData>& section)
+    {
+        const shared_ptr<const SectionData>* found = other.pinned->sections.find(name);
+        if (found != nullptr && *found == section)
+            shared++;
+    });
+
+    return shared;
+}
+
+IniFile VersionedIniFile::View::toIniFile() const
+{
+    IniFile ini;
+    pinned->sections.forEach([&ini](const string& name, const shared_ptr<const SectionData>& section)
+    {
+        ini.data.emplace_hint(ini.data.end(), name, section->keys);
+        if (!section->keyComments.empty())
+            ini.keyComments.emplace_hint(ini.keyComments.end(), name, section->keyComments);
+        if (!section->comment.empty())
+            ini.sectionComments.emplace_hint(ini.sectionComments.end(), name, section->comment);
+    });
+
+    return ini;
+}
+
+const VersionedIniFile::SectionData* VersionedIniFile::View::findSection(const string& section) const
+{
+    const shared_ptr<const SectionData>* found = pinned->sections.find(IniFile::toLower(section));
+    return found == nullptr ? nullptr : found->get();
+}
+
+const shared_ptr<const VersionedIniFile::SectionData>* VersionedIniFile::SectionTable::find(string_view name) const
+{
+    for (const Node* node = root.get(); node != nullptr;)
+    {
+        if (name < node->name)
+            node = node->left.get();
+        else if (node->name < name)
+            node = node->right.get();
+        else
+            return &node->section;
+    }
+
+    return nullptr;
+}
+
+void VersionedIniFile::SectionTable::assign(const string& name, shared_ptr<const SectionData> section)
+{
+    if (find(name) != nullptr)
+    {
+        root = replace(root, name, section);
+        return;
+    }
+
+    auto created = make_shared<Node>();
+    created->name = name;
+    created->section = std::move(section);
+    created->priority = hash<string_view>{}(name);
+    root = insert(root, created);
+}
+
+bool VersionedIniFile::SectionTable::erase(string_view name)
+{
+    if (find(name) == nullptr)
+        return false;
+
+    root = remove(root, name);
+    return true;
+}
+
+VersionedIniFile::SectionTable::NodePtr VersionedIniFile::SectionTable::replace(const NodePtr& node, string_view name,
+                                                                                shared_ptr<const SectionData>& section)
+{
+    // la sezione esiste: stessa forma, si copiano solo i nodi del cammino
+    auto copy = make_shared<Node>(*node);
+    if (name < node->name)
+        copy->left = replace(node->left, name, section);
+    else if (node->name < name)
+        copy->right = replace(node->right, name, section);
+    else
+        copy->section = std::move(section);
+    return copy;
+}
+
+VersionedIniFile::SectionTable::NodePtr VersionedIniFile::SectionTable::insert(const NodePtr& node,
+                                                                               const shared_ptr<Node>& created)
+{
+    // si scende finche' le priorita' lo consentono, poi il sottoalbero viene diviso sotto il nuovo nodo
+    if (!node || created->priority > node->priority)
+    {
+        tie(created->left, created->right) = split(node, created->name);
+        return created;
+    }
+
+    auto copy = make_shared<Node>(*node);
+    if (created->name < node->name)
+        copy->left = insert(node->left, created);
+    else
+        copy->right = insert(node->right, created);
+    return copy;
+}
+
+pair<VersionedIniFile::SectionTable::NodePtr, VersionedIniFile::SectionTable::NodePtr>
+VersionedIniFile::SectionTable::split(const NodePtr& node, string_view name)
+{
+    // nomi minori e maggiori di name, che non e' nell'albero
+    if (!node)
+        return {};
+
+    auto copy = make_shared<Node>(*node);
+    if (node->name < name)
+    {
+        auto parts = split(node->right, name);
+        copy->right = std::move(parts.first);
+        return {std::move(copy), std::move(parts.second)};
+    }
+
+    auto parts = split(node->left, name);
+    copy->left = std::move(parts.second);
+    return {std::move(parts.first), std::move(copy)};
+}
+
+VersionedIniFile::SectionTable::NodePtr VersionedIniFile::SectionTable::remove(const NodePtr& node, string_view name)
+{
+    if (name == node->name)
+        return merge(node->left, node->right);
+
+    auto copy = make_shared<Node>(*node);
+    if (name < node->name)
+        copy->left = remove(node->left, name);
+    else
+        copy->right = remove(node->right, name);
+    return copy;
+}
+
+VersionedIniFile::SectionTable::NodePtr VersionedIniFile::SectionTable::merge(const NodePtr& left, const NodePtr& right)
+{
+    // tutti i nomi di left precedono quelli di right
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (left->priority > right->priority)
+    {
+        auto copy = make_shared<Node>(*left);
+        copy->right = merge(left->right, right);
+        return copy;
+    }
+
+    auto copy = make_shared<Node>(*right);
+    copy->left = merge(left, right->left);
+    return copy;
+}
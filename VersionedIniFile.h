@@ -0,0 +1,127 @@
+//
+// Created by samyb on 19/10/2026.
+//
+
+#ifndef INIMANAGER_VERSIONEDINIFILE_H
+#define INIMANAGER_VERSIONEDINIFILE_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "IniFile.h"
+#include "IniTransaction.h"
+
+// IniFile multiversione: ogni commit crea una nuova versione immutabile che condivide con la
+// precedente tutte le sezioni non modificate, e anche la tabella delle sezioni tranne il cammino
+// verso quelle toccate. Un lettore fissa una versione con pin() e continua a vederla invariata;
+// le versioni che nessuno tiene piu' vengono liberate automaticamente.
+class VersionedIniFile
+{
+    private:
+        struct SectionData
+        {
+            IniSection keys;            // condivise con l'IniFile di partenza e con le versioni precedenti
+            IniSection keyComments;
+            string comment;
+        };
+
+        // Tabella persistente delle sezioni: un treap ordinato per nome, con l'hash del nome come priorita'
+        // al posto di un numero casuale. Una modifica copia solo i nodi tra la radice e la sezione, in media
+        // O(log n); il resto dell'albero resta condiviso con le versioni precedenti.
+        class SectionTable
+        {
+            public:
+                const shared_ptr<const SectionData>* find(string_view name) const;
+                void assign(const string& name, shared_ptr<const SectionData> section);
+                bool erase(string_view name);
+
+                template <typename Visit>
+                void forEach(Visit visit) const     // in ordine di nome
+                {
+                    vector<const Node*> path;
+                    for (const Node* node = root.get(); node != nullptr || !path.empty();)
+                    {
+                        if (node != nullptr)
+                        {
+                            path.push_back(node);
+                            node = node->left.get();
+                            continue;
+                        }
+
+                        node = path.back();
+                        path.pop_back();
+                        visit(node->name, node->section);
+                        node = node->right.get();
+                    }
+                }
+
+            private:
+                struct Node;
+                using NodePtr = shared_ptr<const Node>;
+
+                struct Node
+                {
+                    string name;
+                    shared_ptr<const SectionData> section;
+                    size_t priority;
+                    NodePtr left;
+                    NodePtr right;
+                };
+
+                NodePtr root;
+
+                static NodePtr replace(const NodePtr& node, string_view name, shared_ptr<const SectionData>& section);
+                static NodePtr insert(const NodePtr& node, const shared_ptr<Node>& created);
+                static pair<NodePtr, NodePtr> split(const NodePtr& node, string_view name);
+                static NodePtr remove(const NodePtr& node, string_view name);
+                static NodePtr merge(const NodePtr& left, const NodePtr& right);
+        };
+
+        struct Version
+        {
+            uint64_t number;
+            SectionTable sections;
+        };
+
+    public:
+        class View
+        {
+            public:
+                uint64_t version() const;
+                string get(const string& section, const string& key) const;
+                bool hasSection(const string& section) const;
+                bool hasKey(const string& section, const string& key) const;
+                vector<string> hasKey(const string& key) const;
+                string getSectionComment(const string& section) const;
+                string getKeyComment(const string& section, const string& key) const;
+                size_t sharedSections(const View& other) const;
+                IniFile toIniFile() const;
+
+            private:
+                friend class VersionedIniFile;
+
+                shared_ptr<const Version> pinned;
+
+                explicit View(shared_ptr<const Version> version);
+                const SectionData* findSection(const string& section) const;
+        };
+
+        VersionedIniFile();
+        explicit VersionedIniFile(const IniFile& initial);
+
+        uint64_t commit(const IniTransaction& transaction);
+        uint64_t currentVersion() const;
+        View pin() const;
+        View pin(uint64_t version) const;
+        size_t retainedVersions() const;
+
+    private:
+        mutex commitMutex;          // serializza i commit, i lettori non lo prendono mai
+        mutable mutex versionsMutex;
+        shared_ptr<const Version> latest;
+        mutable map<uint64_t, weak_ptr<const Version>> history;
+
+        void collectGarbage() const;
+};
+
+#endif //INIMANAGER_VERSIONEDINIFILE_H
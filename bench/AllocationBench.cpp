@@ -0,0 +1,105 @@
+#include <cstdio>
+#include "BenchUtil.h"
+#include "../test/AllocationCounter.h"
+
+// Allocazioni per operazione sui metodi principali di IniFile. E' un eseguibile separato perche'
+// operator new sostituito rallenterebbe (poco, ma non zero) tutti gli altri benchmark.
+
+static void allocationArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"sections", "keys", "keyLen", "comments"});
+    b->Args({10, 100, 8, 0});
+    b->Args({10, 100, 32, 30});
+}
+
+static void reportAllocations(benchmark::State& state, const AllocationCounter& counter)
+{
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(counter.allocations()),
+                                                     benchmark::Counter::kAvgIterations);
+    state.counters["bytes/op"] = benchmark::Counter(static_cast<double>(counter.bytes()),
+                                                    benchmark::Counter::kAvgIterations);
+}
+
+static void BM_AllocGet(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 100);
+
+    size_t i = 0;
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(ini.get(query.first, query.second));
+    }
+    reportAllocations(state, counter);
+}
+BENCHMARK(BM_AllocGet)->Apply(allocationArgs);
+
+static void BM_AllocGetView(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 50);
+
+    size_t i = 0;
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(ini.getView(query.first, query.second));
+        benchmark::DoNotOptimize(ini.hasKey(query.first, query.second));
+    }
+    reportAllocations(state, counter);
+}
+BENCHMARK(BM_AllocGetView)->Apply(allocationArgs);
+
+static void BM_AllocSetExisting(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 100);
+
+    size_t i = 0;
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        ini.set(query.first, query.second, "updated");
+    }
+    reportAllocations(state, counter);
+}
+BENCHMARK(BM_AllocSetExisting)->Apply(allocationArgs);
+
+static void BM_AllocLoad(benchmark::State& state)
+{
+    const string fileName = "bench_alloc_load.ini";
+    makeBenchIniFile(benchShape(state)).save(fileName);
+
+    AllocationCounter counter;
+    for (auto _ : state)
+    {
+        IniFile ini;
+        ini.load(fileName);
+        benchmark::DoNotOptimize(ini);
+    }
+    reportAllocations(state, counter);
+
+    remove(fileName.c_str());
+}
+BENCHMARK(BM_AllocLoad)->Apply(allocationArgs);
+
+static void BM_AllocSave(benchmark::State& state)
+{
+    const string fileName = "bench_alloc_save.ini";
+    IniFile ini = makeBenchIniFile(benchShape(state));
+
+    AllocationCounter counter;
+    for (auto _ : state)
+        ini.save(fileName);
+    reportAllocations(state, counter);
+
+    remove(fileName.c_str());
+}
+BENCHMARK(BM_AllocSave)->Apply(allocationArgs);
@@ -0,0 +1,213 @@
+#include <cstdio>
+#include "BenchUtil.h"
+#include "PerfCounters.h"
+#include "../BasicIniFile.h"
+#include "../IniCorpus.h"
+
+// Load e get per ogni combinazione di policy di BasicIniFile (2 x 2 x 4 x 2), con IniFile come riferimento.
+// Il file ha circa 1 MB, il 20% di commenti e nomi con maiuscole casuali.
+
+static IniCorpusOptions policyCorpusOptions()
+{
+    IniCorpusOptions options;
+    options.keysPerSection = 100;
+    options.commentRatio = 0.2;
+    options.caseVariation = true;
+    return IniCorpus::forTargetSize(1 << 20, options);
+}
+
+template <typename Ini>
+static void BM_PolicyLoad(benchmark::State& state)
+{
+    const string fileName = "bench_policy_load.ini";
+    uint64_t bytes = IniCorpus(policyCorpusOptions()).write(fileName);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        Ini ini(fileName);
+        benchmark::DoNotOptimize(ini);
+    }
+
+    remove(fileName.c_str());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+template <typename Ini>
+static void BM_PolicyGet(benchmark::State& state)
+{
+    const string fileName = "bench_policy_get.ini";
+    IniCorpusOptions options = policyCorpusOptions();
+    IniCorpus corpus(options);
+    corpus.write(fileName);
+    Ini ini(fileName);
+    remove(fileName.c_str());
+
+    // nomi con le stesse maiuscole del file, cosi' anche IniCaseSensitive li trova
+    vector<pair<string, string>> queries;
+    for (size_t i = 0; i < 1024; i++)
+    {
+        size_t s = i * 7919 % options.sections;
+        size_t k = i * 104729 % options.keysPerSection;
+        queries.emplace_back(corpus.sectionName(s), corpus.keyName(s, k));
+    }
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(ini.getView(query.first, query.second));
+    }
+}
+
+// Memoria per chiave secondo memoryUsage(), con sezioni da 4 a 1024 chiavi e valori corti (1-32 byte):
+// il tempo misurato e' quello del report, i contatori dicono quanto costa ogni chiave per contenitore.
+template <typename Ini>
+static void BM_MemoryPerKey(benchmark::State& state)
+{
+    const string fileName = "bench_memory_per_key.ini";
+    IniCorpusOptions options;
+    options.keysPerSection = static_cast<size_t>(state.range(0));
+    options.sections = (16 << 10) / options.keysPerSection;
+    IniCorpus(options).write(fileName);
+    Ini ini(fileName);
+    remove(fileName.c_str());
+
+    IniMemoryUsage usage;
+    for (auto _ : state)
+    {
+        usage = ini.memoryUsage();
+        benchmark::DoNotOptimize(usage);
+    }
+
+    auto keys = static_cast<double>(options.sections * options.keysPerSection);
+    state.counters["bytes_per_key"] = static_cast<double>(usage.total.total()) / keys;
+    state.counters["data_per_key"] = static_cast<double>(usage.total.data) / keys;
+    state.counters["nodes_per_key"] = static_cast<double>(usage.total.nodes) / keys;
+    state.counters["slack_per_key"] = static_cast<double>(usage.total.slack) / keys;
+}
+
+// Get su sezioni da 4 a 65536 chiavi (64k chiavi in tutto), per scegliere la soglia di IniAdaptiveStorage:
+// sotto la soglia conta la scansione lineare, sopra l'indice hash, a confronto con albero, vettore e tabella.
+template <typename Ini>
+static void BM_SectionGet(benchmark::State& state)
+{
+    const string fileName = "bench_section_get.ini";
+    IniCorpusOptions options;
+    options.keysPerSection = static_cast<size_t>(state.range(0));
+    options.sections = max<size_t>(1, (64 << 10) / options.keysPerSection);
+    IniCorpus corpus(options);
+    corpus.write(fileName);
+    Ini ini(fileName);
+    remove(fileName.c_str());
+
+    vector<pair<string, string>> queries;
+    for (size_t i = 0; i < 1024; i++)
+    {
+        size_t s = i * 7919 % options.sections;
+        size_t k = i * 104729 % options.keysPerSection;
+        queries.emplace_back(corpus.sectionName(s), corpus.keyName(s, k));
+    }
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(ini.getView(query.first, query.second));
+    }
+}
+
+// Load degli stessi file di BM_SectionGet: la soglia deve tenere conto anche del costo di costruzione delle sezioni
+template <typename Ini>
+static void BM_SectionLoad(benchmark::State& state)
+{
+    const string fileName = "bench_section_load.ini";
+    IniCorpusOptions options;
+    options.keysPerSection = static_cast<size_t>(state.range(0));
+    options.sections = max<size_t>(1, (64 << 10) / options.keysPerSection);
+    uint64_t bytes = IniCorpus(options).write(fileName);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        Ini ini(fileName);
+        benchmark::DoNotOptimize(ini);
+    }
+
+    remove(fileName.c_str());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+template <typename Ini>
+static void registerSectionGet(const string& name)
+{
+    benchmark::RegisterBenchmark(("BM_SectionGet/" + name).c_str(), BM_SectionGet<Ini>)
+            ->ArgName("keys")->RangeMultiplier(4)->Range(4, 64 << 10);
+    benchmark::RegisterBenchmark(("BM_SectionLoad/" + name).c_str(), BM_SectionLoad<Ini>)
+            ->ArgName("keys")->RangeMultiplier(4)->Range(4, 64 << 10)->Unit(benchmark::kMillisecond);
+}
+
+template <size_t... Thresholds>
+static void registerAdaptiveThresholds()
+{
+    (registerSectionGet<BasicIniFile<IniCaseInsensitive, IniKeepComments, IniAdaptiveStorage<Thresholds>>>(
+            "adaptive" + to_string(Thresholds)), ...);
+}
+
+template <typename Ini>
+static void registerMemory(const string& name)
+{
+    benchmark::RegisterBenchmark(("BM_MemoryPerKey/" + name).c_str(), BM_MemoryPerKey<Ini>)
+            ->ArgName("keys")->RangeMultiplier(4)->Range(4, 1024)->Unit(benchmark::kMillisecond);
+}
+
+template <typename Ini>
+static void registerPolicies(const string& name)
+{
+    benchmark::RegisterBenchmark(("BM_PolicyLoad/" + name).c_str(), BM_PolicyLoad<Ini>)->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(("BM_PolicyGet/" + name).c_str(), BM_PolicyGet<Ini>);
+}
+
+template <typename Case, typename Comments, typename Storage>
+static void registerLocking(const string& name)
+{
+    registerPolicies<BasicIniFile<Case, Comments, Storage, IniNoLocking>>(name + "/nolock");
+    registerPolicies<BasicIniFile<Case, Comments, Storage, IniSharedLocking>>(name + "/shared");
+}
+
+template <typename Case, typename Comments>
+static void registerStorage(const string& name)
+{
+    registerLocking<Case, Comments, IniOrderedStorage>(name + "/ordered");
+    registerLocking<Case, Comments, IniFlatStorage>(name + "/flat");
+    registerLocking<Case, Comments, IniHashStorage>(name + "/hash");
+    registerLocking<Case, Comments, IniAdaptiveStorage<>>(name + "/adaptive");
+}
+
+template <typename Case>
+static void registerComments(const string& name)
+{
+    registerStorage<Case, IniKeepComments>(name + "/comments");
+    registerStorage<Case, IniDropComments>(name + "/nocomments");
+}
+
+static const bool policyBenchmarksRegistered = []
+{
+    registerPolicies<IniFile>("IniFile");
+    registerComments<IniCaseInsensitive>("nocase");
+    registerComments<IniCaseSensitive>("case");
+
+    registerMemory<IniFile>("IniFile");
+    registerMemory<BasicIniFile<IniCaseInsensitive, IniKeepComments, IniOrderedStorage>>("ordered");
+    registerMemory<BasicIniFile<IniCaseInsensitive, IniKeepComments, IniFlatStorage>>("flat");
+    registerMemory<BasicIniFile<IniCaseInsensitive, IniKeepComments, IniHashStorage>>("hash");
+    registerMemory<BasicIniFile<IniCaseInsensitive, IniKeepComments, IniAdaptiveStorage<>>>("adaptive");
+
+    registerSectionGet<BasicIniFile<IniCaseInsensitive, IniKeepComments, IniOrderedStorage>>("ordered");
+    registerSectionGet<BasicIniFile<IniCaseInsensitive, IniKeepComments, IniFlatStorage>>("flat");
+    registerSectionGet<BasicIniFile<IniCaseInsensitive, IniKeepComments, IniHashStorage>>("hash");
+    registerAdaptiveThresholds<4, 8, 16, 32, 64>();
+    return true;
+}();
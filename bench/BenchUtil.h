@@ -0,0 +1,70 @@
+#ifndef INIMANAGER_BENCHUTIL_H
+#define INIMANAGER_BENCHUTIL_H
+
+#include <benchmark/benchmark.h>
+#include "../IniFile.h"
+
+// Parametri comuni dei benchmark: numero di sezioni, chiavi per sezione, lunghezza delle chiavi
+// e percentuale di chiavi con commento.
+struct BenchShape
+{
+    int sections;
+    int keysPerSection;
+    int keyLength;
+    int commentPercent;
+};
+
+inline string benchName(const string& prefix, int index, int length)
+{
+    string name = prefix + to_string(index);
+    if (name.size() < static_cast<size_t>(length))
+        name.insert(prefix.size(), length - name.size(), '_');
+    return name;
+}
+
+inline IniFile makeBenchIniFile(const BenchShape& shape)
+{
+    IniFile ini;
+    for (int s = 0; s < shape.sections; s++)
+    {
+        string section = benchName("section", s, shape.keyLength);
+        ini.addSection(section);
+        if ((s * 37) % 100 < shape.commentPercent)
+            ini.setSectionComment(section, "; comment for " + section + "\n");
+
+        for (int k = 0; k < shape.keysPerSection; k++)
+        {
+            string key = benchName("key", k, shape.keyLength);
+            ini.set(section, key, "value" + to_string(k));
+            if ((k * 37 + s) % 100 < shape.commentPercent)
+                ini.setKeyComment(section, key, "; comment for " + key + "\n");
+        }
+    }
+
+    return ini;
+}
+
+// restituisce coppie (sezione, chiave) in cui una frazione hitPercent esiste davvero
+inline vector<pair<string, string>> makeBenchQueries(const BenchShape& shape, int hitPercent, size_t count = 1024)
+{
+    vector<pair<string, string>> queries;
+    queries.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        int s = static_cast<int>((i * 7919) % shape.sections);
+        int k = static_cast<int>((i * 104729) % shape.keysPerSection);
+        bool hit = static_cast<int>(i * 37 % 100) < hitPercent;
+        queries.emplace_back(benchName("section", s, shape.keyLength),
+                             benchName(hit ? "key" : "missing", k, shape.keyLength));
+    }
+
+    return queries;
+}
+
+inline BenchShape benchShape(const benchmark::State& state)
+{
+    return {static_cast<int>(state.range(0)), static_cast<int>(state.range(1)),
+            static_cast<int>(state.range(2)), static_cast<int>(state.range(3))};
+}
+
+#endif //INIMANAGER_BENCHUTIL_H
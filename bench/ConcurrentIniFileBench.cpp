@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include "../ConcurrentIniFile.h"
+
+// Ogni thread aggiorna un contatore nella propria sezione: con un lock unico le scritture
+// si serializzano, con i lock per sezione dovrebbero scalare con il numero di core.
+
+static IniFile globalIni;
+static mutex globalMutex;
+static ConcurrentIniFile concurrentIni;
+
+static string threadSection(const benchmark::State& state)
+{
+    return "worker" + to_string(state.thread_index());
+}
+
+static void BM_SingleLockDisjointSections(benchmark::State& state)
+{
+    string section = threadSection(state);
+    {
+        lock_guard<mutex> lock(globalMutex);
+        globalIni.addSection(section);
+    }
+
+    long counter = 0;
+    for (auto _ : state)
+    {
+        lock_guard<mutex> lock(globalMutex);
+        globalIni.set(section, "counter", to_string(++counter));
+        globalIni.set(section, "status", counter % 2 ? "busy" : "idle");
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_SingleLockDisjointSections)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ConcurrentDisjointSections(benchmark::State& state)
+{
+    string section = threadSection(state);
+    concurrentIni.addSection(section);
+
+    long counter = 0;
+    for (auto _ : state)
+    {
+        concurrentIni.set(section, "counter", to_string(++counter));
+        concurrentIni.set(section, "status", counter % 2 ? "busy" : "idle");
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_ConcurrentDisjointSections)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ConcurrentSharedSection(benchmark::State& state)
+{
+    string key = "counter" + to_string(state.thread_index());
+
+    long counter = 0;
+    for (auto _ : state)
+        concurrentIni.set("shared", key, to_string(++counter));
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentSharedSection)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ConcurrentReadWhileStructuralChanges(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+        concurrentIni.set("stable", "key", "value");
+
+    string section = threadSection(state);
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            concurrentIni.addSection(section);
+            concurrentIni.deleteSection(section);
+        }
+        else
+        {
+            benchmark::DoNotOptimize(concurrentIni.get("stable", "key"));
+        }
+    }
+}
+BENCHMARK(BM_ConcurrentReadWhileStructuralChanges)->ThreadRange(2, 16)->UseRealTime();
@@ -0,0 +1,162 @@
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include "BenchUtil.h"
+#include "PerfCounters.h"
+#include "../IniCorpus.h"
+
+// Load e save su file generati con IniCorpus, da pochi KB in su. Il limite predefinito e' 64 MB;
+// INIMANAGER_BENCH_MAX_BYTES lo alza (es. 4294967296 per arrivare a 4 GB).
+
+static void corpusSizes(benchmark::internal::Benchmark* b)
+{
+    int64_t maxBytes = 64 << 20;
+    if (const char* env = getenv("INIMANAGER_BENCH_MAX_BYTES"))
+        maxBytes = strtoll(env, nullptr, 10);
+
+    b->ArgNames({"bytes", "comments%", "crlf"});
+    for (int64_t bytes = 4 << 10; bytes <= maxBytes; bytes *= 16)
+    {
+        b->Args({bytes, 0, 0});
+        b->Args({bytes, 20, 1});
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+static IniCorpusOptions corpusOptions(const benchmark::State& state)
+{
+    IniCorpusOptions options;
+    options.keysPerSection = 100;
+    options.commentRatio = static_cast<double>(state.range(1)) / 100;
+    options.crlf = state.range(2) != 0;
+    options.longLineRatio = 0.001;
+    options.caseVariation = true;
+    return IniCorpus::forTargetSize(static_cast<uint64_t>(state.range(0)), options);
+}
+
+static void corpusLoad(benchmark::State& state, IniFile::CommentMode comments)
+{
+    const string fileName = "bench_corpus_load.ini";
+    uint64_t bytes = IniCorpus(corpusOptions(state)).write(fileName);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        IniFile ini;
+        ini.load(fileName, comments);
+        benchmark::DoNotOptimize(ini);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    remove(fileName.c_str());
+}
+
+static void BM_CorpusLoad(benchmark::State& state)
+{
+    corpusLoad(state, IniFile::CommentMode::Keep);
+}
+BENCHMARK(BM_CorpusLoad)->Apply(corpusSizes);
+
+static void BM_CorpusLoadSkipComments(benchmark::State& state)
+{
+    corpusLoad(state, IniFile::CommentMode::Skip);
+}
+BENCHMARK(BM_CorpusLoadSkipComments)->Apply(corpusSizes);
+
+static void BM_CorpusLoadLazyComments(benchmark::State& state)
+{
+    corpusLoad(state, IniFile::CommentMode::Lazy);
+}
+BENCHMARK(BM_CorpusLoadLazyComments)->Apply(corpusSizes);
+
+// load e distruzione in una monotonic_buffer_resource per iterazione, contro l'allocatore predefinito: la
+// risorsa parte da un blocco grande il doppio del file, quindi l'heap vede poche allocazioni e il rilascio
+// dei nodi non costa nulla
+static void corpusLoadAndTeardown(benchmark::State& state, bool monotonic)
+{
+    const string fileName = "bench_corpus_pmr.ini";
+    uint64_t bytes = IniCorpus(corpusOptions(state)).write(fileName);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        if (monotonic)
+        {
+            pmr::monotonic_buffer_resource arena(static_cast<size_t>(bytes) * 2);
+            IniFile ini(&arena);
+            ini.load(fileName);
+            benchmark::DoNotOptimize(ini);
+        }
+        else
+        {
+            IniFile ini;
+            ini.load(fileName);
+            benchmark::DoNotOptimize(ini);
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    remove(fileName.c_str());
+}
+
+static void BM_CorpusLoadAndTeardown(benchmark::State& state)
+{
+    corpusLoadAndTeardown(state, false);
+}
+BENCHMARK(BM_CorpusLoadAndTeardown)->Apply(corpusSizes);
+
+static void BM_CorpusLoadAndTeardownMonotonic(benchmark::State& state)
+{
+    corpusLoadAndTeardown(state, true);
+}
+BENCHMARK(BM_CorpusLoadAndTeardownMonotonic)->Apply(corpusSizes);
+
+// solo la distruzione: con la risorsa monotona deallocate() e' vuota e la memoria torna all'heap in blocco
+static void corpusTeardown(benchmark::State& state, bool monotonic)
+{
+    const string fileName = "bench_corpus_teardown.ini";
+    uint64_t bytes = IniCorpus(corpusOptions(state)).write(fileName);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto arena = make_unique<pmr::monotonic_buffer_resource>(static_cast<size_t>(bytes) * 2);
+        auto ini = make_unique<IniFile>(monotonic ? arena.get() : pmr::get_default_resource());
+        ini->load(fileName);
+        state.ResumeTiming();
+
+        ini.reset();
+        arena.reset();
+    }
+
+    remove(fileName.c_str());
+}
+
+static void BM_CorpusTeardown(benchmark::State& state)
+{
+    corpusTeardown(state, false);
+}
+BENCHMARK(BM_CorpusTeardown)->Apply(corpusSizes);
+
+static void BM_CorpusTeardownMonotonic(benchmark::State& state)
+{
+    corpusTeardown(state, true);
+}
+BENCHMARK(BM_CorpusTeardownMonotonic)->Apply(corpusSizes);
+
+static void BM_CorpusSave(benchmark::State& state)
+{
+    const string fileName = "bench_corpus_save.ini";
+    uint64_t bytes = IniCorpus(corpusOptions(state)).write(fileName);
+    IniFile ini;
+    ini.load(fileName);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+        ini.save(fileName);
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    remove(fileName.c_str());
+}
+BENCHMARK(BM_CorpusSave)->Apply(corpusSizes);
@@ -0,0 +1,62 @@
+#include <filesystem>
+#include "BenchUtil.h"
+#include "PerfCounters.h"
+#include "../IniCorpus.h"
+#include "../IniDirectoryLoader.h"
+
+// 200 frammenti da circa 4 KB: caricamento seriale, un IniFile per file unito con set(), contro
+// IniDirectoryLoader con state.range(0) thread. I file restano in page cache, quindi si misura il
+// parsing; a cache fredda conta soprattutto la lettura anticipata.
+
+static const string fragmentDirectory = "bench_conf.d";
+
+static void writeFragments()
+{
+    filesystem::remove_all(fragmentDirectory);
+    filesystem::create_directory(fragmentDirectory);
+
+    IniCorpusOptions options;
+    options.keysPerSection = 20;
+    options.commentRatio = 0.1;
+    for (int i = 0; i < 200; i++)
+    {
+        options.seed = static_cast<uint64_t>(i);
+        IniCorpus(IniCorpus::forTargetSize(4096, options)).write(fragmentDirectory + "/" + benchName("", i, 4) + ".ini");
+    }
+}
+
+static void BM_DirectorySerial(benchmark::State& state)
+{
+    writeFragments();
+    vector<string> files = IniDirectoryLoader::list(fragmentDirectory);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        IniFile merged;
+        for (const auto& file : files)
+        {
+            IniFile fragment(file);
+            for (const auto& change : IniFile::diff(IniFile(), fragment))
+                merged.set(change.section, change.key, change.newValue);
+        }
+        benchmark::DoNotOptimize(merged);
+    }
+
+    filesystem::remove_all(fragmentDirectory);
+}
+BENCHMARK(BM_DirectorySerial)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_DirectoryLoader(benchmark::State& state)
+{
+    writeFragments();
+    IniDirectoryLoader loader(static_cast<unsigned>(state.range(0)));
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(loader.load(fragmentDirectory));
+
+    filesystem::remove_all(fragmentDirectory);
+}
+BENCHMARK(BM_DirectoryLoader)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,299 @@
+#include <cstdio>
+#include "BenchUtil.h"
+#include "PerfCounters.h"
+
+// Un benchmark per ogni metodo pubblico di IniFile. Gli argomenti sono, nell'ordine:
+// sezioni, chiavi per sezione, lunghezza dei nomi, percentuale di commenti e (per le ricerche)
+// percentuale di chiavi trovate.
+
+static void shapeArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"sections", "keys", "keyLen", "comments"});
+    for (auto shape : vector<vector<int64_t>>{{1, 10}, {10, 100}, {100, 100}, {1000, 10}, {10, 10000}})
+    {
+        for (int64_t keyLength : {8, 32})
+        {
+            for (int64_t comments : {0, 30})
+                b->Args({shape[0], shape[1], keyLength, comments});
+        }
+    }
+}
+
+static void lookupArgs(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"sections", "keys", "keyLen", "comments", "hit%"});
+    for (auto shape : vector<vector<int64_t>>{{1, 10}, {100, 100}, {10, 10000}})
+    {
+        for (int64_t keyLength : {8, 32})
+        {
+            for (int64_t hit : {0, 50, 100})
+                b->Args({shape[0], shape[1], keyLength, 0, hit});
+        }
+    }
+}
+
+static string benchFileName(const char* name)
+{
+    return string("bench_") + name + ".ini";
+}
+
+static void BM_Load(benchmark::State& state)
+{
+    const string fileName = benchFileName("load");
+    makeBenchIniFile(benchShape(state)).save(fileName);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        IniFile ini;
+        ini.load(fileName);
+        benchmark::DoNotOptimize(ini);
+    }
+
+    remove(fileName.c_str());
+}
+BENCHMARK(BM_Load)->Apply(shapeArgs);
+
+static void BM_Save(benchmark::State& state)
+{
+    const string fileName = benchFileName("save");
+    IniFile ini = makeBenchIniFile(benchShape(state));
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+        ini.save(fileName);
+
+    remove(fileName.c_str());
+}
+BENCHMARK(BM_Save)->Apply(shapeArgs);
+
+static void BM_Print(benchmark::State& state)
+{
+    IniFile ini = makeBenchIniFile(benchShape(state));
+    bool comments = state.range(3) > 0;
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ini.print(comments));
+}
+BENCHMARK(BM_Print)->Apply(shapeArgs);
+
+static void BM_Get(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, static_cast<int>(state.range(4)));
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(ini.get(query.first, query.second));
+    }
+}
+BENCHMARK(BM_Get)->Apply(lookupArgs);
+
+static void BM_HasKey(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, static_cast<int>(state.range(4)));
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(ini.hasKey(query.first, query.second));
+    }
+}
+BENCHMARK(BM_HasKey)->Apply(lookupArgs);
+
+static void BM_HasKeyAnySection(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, static_cast<int>(state.range(4)));
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ini.hasKey(queries[i++ % queries.size()].second));
+}
+BENCHMARK(BM_HasKeyAnySection)->Apply(lookupArgs);
+
+static void BM_HasSection(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+
+    vector<string> sections;
+    for (int i = 0; i < 1024; i++)
+    {
+        bool hit = i * 37 % 100 < state.range(4);
+        sections.push_back(benchName(hit ? "section" : "nosection", i % shape.sections, shape.keyLength));
+    }
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ini.hasSection(sections[i++ % sections.size()]));
+}
+BENCHMARK(BM_HasSection)->Apply(lookupArgs);
+
+static void BM_SetExisting(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 100);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        ini.set(query.first, query.second, "updated");
+    }
+}
+BENCHMARK(BM_SetExisting)->Apply(shapeArgs);
+
+static void BM_SetAndDeleteNewKey(benchmark::State& state)
+{
+    // una chiave nuova viene inserita e poi rimossa, cosi' la dimensione del file resta costante
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 0);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        ini.set(query.first, query.second, "new");
+        ini.deleteKey(query.first, query.second);
+    }
+}
+BENCHMARK(BM_SetAndDeleteNewKey)->Apply(shapeArgs);
+
+static void BM_AddAndDeleteSection(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        string section = benchName("newsection", static_cast<int>(i++ % 1024), shape.keyLength);
+        ini.addSection(section);
+        ini.deleteSection(section);
+    }
+}
+BENCHMARK(BM_AddAndDeleteSection)->Apply(shapeArgs);
+
+static void BM_AddExistingSection(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+        ini.addSection(benchName("section", static_cast<int>(i++ % shape.sections), shape.keyLength));
+}
+BENCHMARK(BM_AddExistingSection)->Apply(shapeArgs);
+
+static void BM_DeleteMissing(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 0);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(ini.deleteKey(query.first, query.second));
+        benchmark::DoNotOptimize(ini.deleteSection(query.second));
+    }
+}
+BENCHMARK(BM_DeleteMissing)->Apply(shapeArgs);
+
+static void BM_SetComments(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 100);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        ini.setSectionComment(query.first, "; section comment\n");
+        ini.setKeyComment(query.first, query.second, "; key comment\n");
+    }
+}
+BENCHMARK(BM_SetComments)->Apply(shapeArgs);
+
+static void BM_GetComments(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 100);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(ini.getSectionComment(query.first));
+        benchmark::DoNotOptimize(ini.getKeyComment(query.first, query.second));
+    }
+}
+BENCHMARK(BM_GetComments)->Apply(shapeArgs);
+
+static void BM_Diff(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile before = makeBenchIniFile(shape);
+    IniFile after = before;
+    for (const auto& query : makeBenchQueries(shape, 100, 16))
+        after.set(query.first, query.second, "changed");
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(IniFile::diff(before, after));
+}
+BENCHMARK(BM_Diff)->Apply(shapeArgs);
+
+static void BM_Copy(benchmark::State& state)
+{
+    IniFile ini = makeBenchIniFile(benchShape(state));
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        IniFile copy = ini;     // sezioni condivise: si copiano solo nomi e puntatori
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_Copy)->Apply(shapeArgs);
+
+static void BM_CopyAndSet(benchmark::State& state)
+{
+    BenchShape shape = benchShape(state);
+    IniFile ini = makeBenchIniFile(shape);
+    auto queries = makeBenchQueries(shape, 100, 1);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        IniFile copy = ini;
+        copy.set(queries[0].first, queries[0].second, "changed");     // clona una sola sezione
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_CopyAndSet)->Apply(shapeArgs);
@@ -0,0 +1,60 @@
+#include <cstdio>
+#include "BenchUtil.h"
+#include "PerfCounters.h"
+#include "../IniCorpus.h"
+#include "../IniSnapshot.h"
+
+// Avvio con una ricerca: parsing del testo contro apertura dello snapshot mappato, con e senza checksum.
+
+static void snapshotSizes(benchmark::internal::Benchmark* b)
+{
+    b->ArgName("bytes");
+    for (int64_t bytes : {64 << 10, 1 << 20, 16 << 20})
+        b->Arg(bytes);
+    b->Unit(benchmark::kMicrosecond);
+}
+
+static string writeSnapshotCorpus(const benchmark::State& state)
+{
+    const string fileName = "bench_snapshot.ini";
+    IniCorpusOptions options;
+    options.keysPerSection = 50;
+    options.commentRatio = 0.1;
+    IniCorpus(IniCorpus::forTargetSize(static_cast<uint64_t>(state.range(0)), options)).write(fileName);
+    IniSnapshot::openFor(fileName);
+    return fileName;
+}
+
+static void BM_StartupTextParse(benchmark::State& state)
+{
+    string fileName = writeSnapshotCorpus(state);
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        IniFile ini(fileName);
+        benchmark::DoNotOptimize(ini.getView("section0", "key0"));
+    }
+
+    remove(fileName.c_str());
+    remove(IniSnapshot::defaultPath(fileName).c_str());
+}
+BENCHMARK(BM_StartupTextParse)->Apply(snapshotSizes);
+
+static void BM_StartupSnapshot(benchmark::State& state)
+{
+    string fileName = writeSnapshotCorpus(state);
+    bool verify = state.range(1) != 0;
+
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        IniSnapshot snapshot = IniSnapshot::open(IniSnapshot::defaultPath(fileName), verify);
+        benchmark::DoNotOptimize(snapshot.getView("section0", "key0"));
+    }
+
+    remove(fileName.c_str());
+    remove(IniSnapshot::defaultPath(fileName).c_str());
+}
+BENCHMARK(BM_StartupSnapshot)->ArgNames({"bytes", "checksum"})
+    ->ArgsProduct({{64 << 10, 1 << 20, 16 << 20}, {0, 1}})->Unit(benchmark::kMicrosecond);
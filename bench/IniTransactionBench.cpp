@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include "../IniTransaction.h"
+#include "../VersionedIniFile.h"
+
+// Aggiornamento di state.range(0) chiavi distribuite su 10 sezioni gia' popolate.
+
+static IniFile populatedIniFile()
+{
+    IniFile ini;
+    for (int s = 0; s < 10; s++)
+    {
+        for (int k = 0; k < 1000; k++)
+            ini.set("section" + to_string(s), "key" + to_string(k), "value");
+    }
+    return ini;
+}
+
+static void BM_IndividualSets(benchmark::State& state)
+{
+    IniFile base = populatedIniFile();
+    IniFile ini;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ini = base;
+        state.ResumeTiming();
+
+        for (int i = 0; i < state.range(0); i++)
+            ini.set("Section" + to_string(i % 10), "Key" + to_string(i * 7 % 2000), "updated");
+        benchmark::DoNotOptimize(ini);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IndividualSets)->Arg(50)->Arg(500)->Arg(5000);
+
+static void BM_TransactionCommit(benchmark::State& state)
+{
+    IniFile base = populatedIniFile();
+    IniFile ini;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ini = base;
+        state.ResumeTiming();
+
+        IniTransaction transaction;
+        for (int i = 0; i < state.range(0); i++)
+            transaction.set("Section" + to_string(i % 10), "Key" + to_string(i * 7 % 2000), "updated");
+        ini.commit(transaction);
+        benchmark::DoNotOptimize(ini);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransactionCommit)->Arg(50)->Arg(500)->Arg(5000);
+
+// Commit di una sola chiave su un VersionedIniFile con state.range(0) sezioni: la tabella delle sezioni
+// si copia solo lungo il cammino, quindi il costo cresce con il logaritmo delle sezioni.
+static void BM_VersionedCommit(benchmark::State& state)
+{
+    IniFile initial;
+    for (int s = 0; s < state.range(0); s++)
+        initial.set("section" + to_string(s), "key", "value");
+    VersionedIniFile versioned(initial);
+
+    int i = 0;
+    for (auto _ : state)
+    {
+        IniTransaction transaction;
+        transaction.set("section" + to_string(i++ % state.range(0)), "key", "updated");
+        benchmark::DoNotOptimize(versioned.commit(transaction));
+    }
+}
+BENCHMARK(BM_VersionedCommit)->Arg(100)->Arg(10000)->Arg(100000);
@@ -0,0 +1,63 @@
+#include "BenchUtil.h"
+#include "PerfCounters.h"
+#include "../LayeredIniFile.h"
+
+// Ricerca su state.range(0) livelli: get su ogni livello fino al primo che contiene la chiave,
+// contro una sola ricerca nell'indice appiattito. Meta' delle chiavi cercate non esiste in nessun livello.
+
+static const BenchShape layerShape{10, 100, 16, 0};
+
+static vector<IniFile> makeLayers(int count)
+{
+    vector<IniFile> layers;
+    for (int i = 0; i < count; i++)
+    {
+        // ogni livello ridefinisce una parte diversa delle chiavi
+        IniFile layer;
+        for (int s = 0; s < layerShape.sections; s++)
+        {
+            for (int k = i; k < layerShape.keysPerSection; k += count)
+                layer.set(benchName("section", s, layerShape.keyLength), benchName("key", k, layerShape.keyLength),
+                          "layer" + to_string(i));
+        }
+        layers.push_back(std::move(layer));
+    }
+
+    return layers;
+}
+
+static void BM_LayersSequentialGet(benchmark::State& state)
+{
+    vector<IniFile> layers = makeLayers(static_cast<int>(state.range(0)));
+    auto queries = makeBenchQueries(layerShape, 50);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        string_view value;
+        for (auto layer = layers.rbegin(); layer != layers.rend() && value.empty(); ++layer)
+            value = layer->getView(query.first, query.second);
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_LayersSequentialGet)->ArgName("layers")->RangeMultiplier(2)->Range(1, 8);
+
+static void BM_LayeredIniFileGet(benchmark::State& state)
+{
+    LayeredIniFile layered;
+    int count = 0;
+    for (auto& layer : makeLayers(static_cast<int>(state.range(0))))
+        layered.addLayer("layer" + to_string(count++), std::move(layer));
+    auto queries = makeBenchQueries(layerShape, 50);
+
+    size_t i = 0;
+    PerfCounterScope perf(state);
+    for (auto _ : state)
+    {
+        const auto& query = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(layered.getView(query.first, query.second));
+    }
+}
+BENCHMARK(BM_LayeredIniFileGet)->ArgName("layers")->RangeMultiplier(2)->Range(1, 8);
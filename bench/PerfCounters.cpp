@@ -0,0 +1,146 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+static int openCounter(uint32_t type, uint64_t config)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;    // permesso anche con perf_event_paranoid = 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+static uint64_t cacheMiss(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+#endif
+
+static bool perfDisabled()
+{
+    const char* env = getenv("INIMANAGER_BENCH_PERF");
+    return env != nullptr && strcmp(env, "0") == 0;
+}
+
+PerfCounters::PerfCounters()
+{
+#ifdef __linux__
+    if (perfDisabled())
+        return;
+
+    const struct { const char* name; uint32_t type; uint64_t config; } events[] = {
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"L1D-misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D)},
+        {"LLC-misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL)},
+        {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    for (const auto& event : events)
+    {
+        int fd = openCounter(event.type, event.config);
+        if (fd >= 0)
+            counters.push_back({event.name, fd});
+    }
+
+    static bool warned = false;
+    if (counters.empty() && !warned)
+    {
+        warned = true;
+        cerr << "perf_event_open not permitted: hardware counters will not be reported" << endl;
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (const auto& counter : counters)
+        close(counter.fd);
+#endif
+}
+
+bool PerfCounters::available() const
+{
+    return !counters.empty();
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+    for (const auto& counter : counters)
+    {
+        ioctl(counter.fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+void PerfCounters::stop()
+{
+#ifdef __linux__
+    for (const auto& counter : counters)
+        ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+}
+
+vector<pair<string, double>> PerfCounters::values() const
+{
+    vector<pair<string, double>> result;
+#ifdef __linux__
+    for (const auto& counter : counters)
+    {
+        uint64_t data[3];   // valore, tempo abilitato, tempo in esecuzione
+        if (read(counter.fd, data, sizeof(data)) != sizeof(data) || data[2] == 0)
+            continue;
+
+        double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        result.emplace_back(counter.name, static_cast<double>(data[0]) * scale);
+    }
+#endif
+    return result;
+}
+
+PerfCounterScope::PerfCounterScope(benchmark::State& state) : state(state)
+{
+    counters.start();
+}
+
+PerfCounterScope::~PerfCounterScope()
+{
+    counters.stop();
+    if (!counters.available())
+        return;
+
+    double cycles = 0;
+    double instructions = 0;
+    for (const auto& value : counters.values())
+    {
+        state.counters[value.first + "/op"] = benchmark::Counter(value.second, benchmark::Counter::kAvgIterations);
+        if (value.first == "cycles")
+            cycles = value.second;
+        else if (value.first == "instructions")
+            instructions = value.second;
+    }
+
+    if (cycles > 0 && instructions > 0)
+        state.counters["IPC"] = instructions / cycles;
+}
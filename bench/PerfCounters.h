@@ -0,0 +1,50 @@
+#ifndef INIMANAGER_PERFCOUNTERS_H
+#define INIMANAGER_PERFCOUNTERS_H
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Contatori hardware del thread corrente tramite perf_event_open (solo Linux). Ogni evento viene aperto
+// separatamente: quelli non supportati o non permessi (container, perf_event_paranoid alto) vengono
+// semplicemente saltati. Con INIMANAGER_BENCH_PERF=0 non viene aperto nulla.
+class PerfCounters
+{
+    public:
+        PerfCounters();
+        ~PerfCounters();
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        bool available() const;
+        void start();
+        void stop();
+        vector<pair<string, double>> values() const;   // nome e conteggio, scalato se c'e' stato multiplexing
+
+    private:
+        struct Counter
+        {
+            string name;
+            int fd;
+        };
+
+        vector<Counter> counters;
+};
+
+// Misura i contatori dalla costruzione alla distruzione e li riporta nel benchmark come valori per iterazione.
+// Va creata subito prima del ciclo sugli stati, dopo la preparazione dei dati.
+class PerfCounterScope
+{
+    public:
+        explicit PerfCounterScope(benchmark::State& state);
+        ~PerfCounterScope();
+
+    private:
+        benchmark::State& state;
+        PerfCounters counters;
+};
+
+#endif //INIMANAGER_PERFCOUNTERS_H
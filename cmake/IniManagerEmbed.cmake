@@ -0,0 +1,35 @@
+# inimanager_embed(<target> <file.ini> [NAMESPACE <name>] [HEADER <name.h>])
+#
+# Genera a tempo di build un header con il contenuto di <file.ini> come costanti C++ (vedi
+# tools/IniEmbedGenerator.cpp) e lo rende includibile da <target>. Il namespace predefinito e'
+# il nome del file senza estensione, l'header predefinito <namespace>.h; il file viene rigenerato
+# quando cambia l'INI o il generatore.
+
+set(INIMANAGER_EMBED_TOOL ${CMAKE_PROJECT_NAME}_embed CACHE INTERNAL "Target that generates embedded INI headers")
+
+function(inimanager_embed target ini_file)
+    cmake_parse_arguments(EMBED "" "NAMESPACE;HEADER" "" ${ARGN})
+
+    get_filename_component(ini_path ${ini_file} ABSOLUTE)
+    if (NOT EMBED_NAMESPACE)
+        get_filename_component(EMBED_NAMESPACE ${ini_file} NAME_WE)
+        string(MAKE_C_IDENTIFIER ${EMBED_NAMESPACE} EMBED_NAMESPACE)
+    endif ()
+    if (NOT EMBED_HEADER)
+        set(EMBED_HEADER ${EMBED_NAMESPACE}.h)
+    endif ()
+
+    set(output_dir ${CMAKE_CURRENT_BINARY_DIR}/inimanager_embed/${target})
+    set(header ${output_dir}/${EMBED_HEADER})
+
+    add_custom_command(
+            OUTPUT ${header}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${output_dir}
+            COMMAND ${INIMANAGER_EMBED_TOOL} ${ini_path} ${header} ${EMBED_NAMESPACE}
+            DEPENDS ${INIMANAGER_EMBED_TOOL} ${ini_path}
+            COMMENT "Embedding ${ini_file} as ${EMBED_HEADER}"
+            VERBATIM)
+
+    target_sources(${target} PRIVATE ${header})
+    target_include_directories(${target} PRIVATE ${output_dir})
+endfunction()
@@ -0,0 +1,121 @@
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.h"
+
+// contatori per thread: i thread di gtest o dei test concorrenti non sporcano le misure
+static thread_local uint64_t threadAllocations = 0;
+static thread_local uint64_t threadBytes = 0;
+
+static void* countedAllocation(size_t size, size_t alignment)
+{
+    threadAllocations++;
+    threadBytes += size;
+
+    if (size == 0)
+        size = 1;
+
+    void* pointer = nullptr;
+    if (alignment <= alignof(max_align_t))
+        pointer = malloc(size);
+    else if (posix_memalign(&pointer, alignment, size) != 0)
+        pointer = nullptr;
+
+    return pointer;
+}
+
+void* operator new(size_t size)
+{
+    void* pointer = countedAllocation(size, alignof(max_align_t));
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocation(size, alignof(max_align_t));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocation(size, alignof(max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    void* pointer = countedAllocation(size, static_cast<size_t>(alignment));
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept
+{
+    free(pointer);
+}
+
+AllocationCounter::AllocationCounter()
+{
+    reset();
+}
+
+uint64_t AllocationCounter::allocations() const
+{
+    return threadAllocations - startAllocations;
+}
+
+uint64_t AllocationCounter::bytes() const
+{
+    return threadBytes - startBytes;
+}
+
+void AllocationCounter::reset()
+{
+    startAllocations = threadAllocations;
+    startBytes = threadBytes;
+}
@@ -0,0 +1,24 @@
+#ifndef INIMANAGER_ALLOCATIONCOUNTER_H
+#define INIMANAGER_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Conta le allocazioni fatte dal thread corrente tra la costruzione e la lettura.
+// Il conteggio viene da operator new/delete globali sostituiti in AllocationCounter.cpp,
+// che va linkato nell'eseguibile (test o benchmark) che lo usa.
+class AllocationCounter
+{
+    public:
+        AllocationCounter();
+
+        uint64_t allocations() const;
+        uint64_t bytes() const;
+        void reset();
+
+    private:
+        uint64_t startAllocations;
+        uint64_t startBytes;
+};
+
+#endif //INIMANAGER_ALLOCATIONCOUNTER_H
@@ -0,0 +1,218 @@
+#include <cstdio>
+#include <fstream>
+#include <memory_resource>
+#include "gtest/gtest.h"
+#include "AllocationCounter.h"
+#include "../IniFile.h"
+
+// Regressione sulle allocazioni: le letture a regime non devono toccare l'heap. I nomi sono piu' lunghi
+// del buffer SSO di std::string, cosi' una copia o un toLower nascosti verrebbero contati.
+
+class AllocationTest : public ::testing::Test
+{
+    protected:
+        IniFile iniFile;
+        const string section = "Application_Settings_Section";
+        const string key = "Connection_Timeout_Milliseconds";
+        const string missingKey = "Missing_Key_With_A_Long_Name";
+        const string shortValueKey = "short";
+
+        void SetUp() override
+        {
+            iniFile.set(section, key, "a value that does not fit in the small string buffer");
+            iniFile.set(section, shortValueKey, "42");
+            iniFile.setSectionComment(section, "; comment\n");
+
+            // riscaldamento: il buffer di folding del thread viene allocato una sola volta
+            iniFile.hasKey(section, key);
+        }
+};
+
+TEST_F(AllocationTest, ReadsDoNotAllocate)
+{
+    AllocationCounter counter;
+
+    EXPECT_EQ(iniFile.getView(section, key), "a value that does not fit in the small string buffer");
+    EXPECT_TRUE(iniFile.getView(section, missingKey).empty());
+    EXPECT_TRUE(iniFile.hasSection(section));
+    EXPECT_FALSE(iniFile.hasSection(missingKey));
+    EXPECT_TRUE(iniFile.hasKey(section, key));
+    EXPECT_FALSE(iniFile.hasKey(section, missingKey));
+    EXPECT_TRUE(iniFile.hasKey(missingKey).empty());
+    EXPECT_EQ(iniFile.get(section, shortValueKey), "42");   // valore entro il buffer SSO
+
+    EXPECT_EQ(counter.allocations(), 0);
+}
+
+TEST_F(AllocationTest, MissingLookupsAndDeletesDoNotAllocate)
+{
+    AllocationCounter counter;
+
+    EXPECT_EQ(iniFile.get(section, missingKey), "");
+    EXPECT_EQ(iniFile.getKeyComment(section, missingKey), "");
+    EXPECT_FALSE(iniFile.deleteKey(section, missingKey));
+    EXPECT_FALSE(iniFile.deleteSection(missingKey));
+
+    EXPECT_EQ(counter.allocations(), 0);
+}
+
+TEST_F(AllocationTest, ReportsAllocationsPerMutation)
+{
+    // non e' un vincolo: documenta quanto costano le operazioni che modificano il file
+    AllocationCounter counter;
+    iniFile.set(section, key, "another value that does not fit in the small string buffer");
+    uint64_t overwrite = counter.allocations();
+
+    counter.reset();
+    iniFile.save("allocation_test.ini");
+    uint64_t save = counter.allocations();
+
+    counter.reset();
+    IniFile loaded;
+    loaded.load("allocation_test.ini");
+    uint64_t load = counter.allocations();
+
+    RecordProperty("set_overwrite_allocations", static_cast<int>(overwrite));
+    RecordProperty("save_allocations", static_cast<int>(save));
+    RecordProperty("load_allocations", static_cast<int>(load));
+    EXPECT_GT(load, 0);
+    EXPECT_EQ(loaded.getView(section, key), "another value that does not fit in the small string buffer");
+
+    remove("allocation_test.ini");
+}
+
+TEST(AllocationLoadTest, SkippedCommentsDoNotAllocate)
+{
+    const string commented = "allocation_commented.ini";
+    const string plain = "allocation_plain.ini";
+    {
+        ofstream file(commented);
+        file << "; a section comment long enough to need its own heap allocation\n[Application_Settings]\n"
+                "; a key comment long enough to need its own heap allocation\nConnection_Timeout=30\n"
+                "; another key comment that would be stored in keyComments\nRetry_Count=3\n";
+        ofstream plainFile(plain);
+        plainFile << "[Application_Settings]\nConnection_Timeout=30\nRetry_Count=3\n";
+    }
+
+    // il buffer di lettura ha dimensioni diverse ma resta una sola allocazione in entrambi i casi
+    AllocationCounter counter;
+    IniFile skipped;
+    skipped.load(commented, IniFile::CommentMode::Skip);
+    uint64_t skip = counter.allocations();
+
+    counter.reset();
+    IniFile reference;
+    reference.load(plain);
+    uint64_t keep = counter.allocations();
+
+    EXPECT_EQ(skip, keep);
+    EXPECT_EQ(skipped.print(true), reference.print(true));
+
+    remove(commented.c_str());
+    remove(plain.c_str());
+}
+
+TEST(AllocationLoadTest, LazyCommentsAllocateOnFirstAccess)
+{
+    const string fileName = "allocation_lazy.ini";
+    {
+        ofstream file(fileName);
+        file << "[Application_Settings]\n";
+        for (int i = 0; i < 20; i++)
+            file << "; a key comment long enough to need its own heap allocation\nkey" << i << "=" << i << "\n";
+    }
+
+    AllocationCounter counter;
+    IniFile kept;
+    kept.load(fileName);
+    uint64_t keep = counter.allocations();
+
+    counter.reset();
+    IniFile lazy;
+    lazy.load(fileName, IniFile::CommentMode::Lazy);
+    uint64_t lazyLoad = counter.allocations();
+
+    counter.reset();
+    EXPECT_EQ(lazy.getKeyComment("application_settings", "key7"), kept.getKeyComment("application_settings", "key7"));
+    uint64_t firstAccess = counter.allocations();
+
+    RecordProperty("keep_load_allocations", static_cast<int>(keep));
+    RecordProperty("lazy_load_allocations", static_cast<int>(lazyLoad));
+    EXPECT_LT(lazyLoad + 20, keep);     // almeno una stringa di commento in meno per chiave
+    EXPECT_GT(firstAccess, 20);
+
+    remove(fileName.c_str());
+}
+
+TEST(AllocationLoadTest, MemoryResourceHoldsAllStorage)
+{
+    const string small = "pmr_small.ini";
+    const string large = "pmr_large.ini";
+    {
+        ofstream smallFile(small);
+        smallFile << "[Application_Settings]\nConnection_Timeout=30\n";
+        ofstream largeFile(large);
+        for (int section = 0; section < 10; section++)
+        {
+            largeFile << "; a section comment long enough to need its own heap allocation\n"
+                      << "[Application_Settings_" << section << "]\n";
+            for (int i = 0; i < 20; i++)
+                largeFile << "Connection_Timeout_Milliseconds_" << i << "=a value longer than the SSO buffer\n";
+        }
+    }
+
+    // la memoria delle risorse e' preparata prima del conteggio e null_memory_resource vieta di chiederne
+    // altra: a carico dell'heap restano solo i buffer di appoggio del load, quindi 200 chiavi costano come una
+    vector<char> smallBuffer(1 << 12);
+    vector<char> largeBuffer(1 << 20);
+    pmr::monotonic_buffer_resource smallArena(smallBuffer.data(), smallBuffer.size(), pmr::null_memory_resource());
+    pmr::monotonic_buffer_resource largeArena(largeBuffer.data(), largeBuffer.size(), pmr::null_memory_resource());
+
+    AllocationCounter counter;
+    IniFile smallFile(&smallArena);
+    smallFile.load(small);
+    uint64_t baseline = counter.allocations();
+
+    counter.reset();
+    IniFile largeFile(&largeArena);
+    largeFile.load(large);
+    uint64_t withResource = counter.allocations();
+
+    counter.reset();
+    IniFile reference(large);
+    uint64_t withoutResource = counter.allocations();
+
+    RecordProperty("resource_load_allocations", static_cast<int>(withResource));
+    RecordProperty("default_load_allocations", static_cast<int>(withoutResource));
+    EXPECT_EQ(withResource, baseline);
+    EXPECT_GT(withoutResource, 400);
+    EXPECT_EQ(largeFile.print(true), reference.print(true));
+
+    remove(small.c_str());
+    remove(large.c_str());
+}
+
+TEST(AllocationLoadTest, CopyAllocatesPerSectionOnly)
+{
+    IniFile original;
+    for (int section = 0; section < 10; section++)
+    {
+        for (int i = 0; i < 100; i++)
+            original.set("Section_" + to_string(section), "Connection_Timeout_Milliseconds_" + to_string(i),
+                         "a value that does not fit in the small string buffer");
+    }
+
+    // un nodo per sezione (nomi entro il buffer SSO), nessuna chiave copiata
+    AllocationCounter counter;
+    IniFile copy = original;
+    EXPECT_EQ(counter.allocations(), 10);
+
+    // la prima modifica clona solo la sezione toccata: un blocco e tre allocazioni per chiave (nodo, nome, valore)
+    counter.reset();
+    copy.set("Section_0", "Connection_Timeout_Milliseconds_0", "changed");
+    uint64_t firstSet = counter.allocations();
+    counter.reset();
+    copy.set("Section_0", "Connection_Timeout_Milliseconds_0", "changed again");
+    EXPECT_EQ(firstSet - counter.allocations(), 1 + 3 * 100);
+    EXPECT_EQ(copy.sharedSections(original), 9);
+}
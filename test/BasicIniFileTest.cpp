@@ -0,0 +1,353 @@
+#include <cstdio>
+#include <fstream>
+#include <memory_resource>
+#include "gtest/gtest.h"
+#include "AllocationCounter.h"
+#include "../BasicIniFile.h"
+#include "../IniFile.h"
+#include "../IniTransaction.h"
+
+// Comportamento comune a tutte le combinazioni di contenitore e sincronizzazione
+
+template <typename T>
+class BasicIniFileTest : public ::testing::Test
+{
+};
+
+using StorageCombinations = ::testing::Types<
+        BasicIniFile<>,
+        BasicIniFile<IniCaseInsensitive, IniKeepComments, IniFlatStorage>,
+        BasicIniFile<IniCaseInsensitive, IniKeepComments, IniHashStorage>,
+        BasicIniFile<IniCaseInsensitive, IniKeepComments, IniAdaptiveStorage<2>>,     // promossa gia' alla terza chiave
+        BasicIniFile<IniCaseInsensitive, IniDropComments, IniFlatStorage, IniSharedLocking>,
+        BasicIniFile<IniCaseInsensitive, IniKeepComments, IniFlatStorage, IniNoLocking, allocator<char>>>;
+TYPED_TEST_SUITE(BasicIniFileTest, StorageCombinations);
+
+TYPED_TEST(BasicIniFileTest, SetGetDelete)
+{
+    TypeParam ini;
+    ini.set("Network", "Port", "8080");
+    ini.set("network", "host", "localhost");
+    ini.set("general", "name", "TestApp");
+    ini.set("network", "port", "9090");
+
+    EXPECT_EQ(ini.get("NETWORK", "port"), "9090");
+    EXPECT_EQ(ini.getView("network", "HOST"), "localhost");
+    EXPECT_EQ(ini.get("network", "missing"), "");
+    EXPECT_TRUE(ini.hasSection("General"));
+    EXPECT_TRUE(ini.hasKey("general", "name"));
+
+    EXPECT_TRUE(ini.deleteKey("network", "host"));
+    EXPECT_FALSE(ini.deleteKey("network", "host"));
+    EXPECT_TRUE(ini.deleteSection("general"));
+    EXPECT_FALSE(ini.hasSection("general"));
+    EXPECT_EQ(ini.get("network", "port"), "9090");
+}
+
+TYPED_TEST(BasicIniFileTest, LoadMatchesIniFile)
+{
+    const string fileName = "basic_ini_test.ini";
+    {
+        ofstream file(fileName, ios::binary);
+        file << "top=1\r\n; section comment\r\n[General]\r\nName=TestApp\r\nno equals\r\n"
+                "; key comment\r\nversion=1.0\r\n[network]\r\nport=8080\r\nport=9090\r\n[empty]\r\n";
+    }
+
+    TypeParam ini(fileName);
+    IniFile reference(fileName);
+    remove(fileName.c_str());
+
+    for (const char* section : {"", "general", "network", "empty"})
+    {
+        EXPECT_EQ(ini.hasSection(section), reference.hasSection(section)) << section;
+        for (const char* key : {"top", "name", "version", "port", "no equals"})
+            EXPECT_EQ(ini.get(section, key), reference.get(section, key)) << section << "." << key;
+    }
+}
+
+TYPED_TEST(BasicIniFileTest, MemoryUsageMatchesIniFilePayload)
+{
+    TypeParam ini;
+    IniFile reference;
+    const string longValue(100, 'v');
+    for (int i = 0; i < 10; i++)
+    {
+        ini.set("section", "key" + to_string(i), longValue);
+        reference.set("section", "key" + to_string(i), longValue);
+    }
+
+    // i caratteri sono gli stessi per ogni contenitore; nodi e bucket cambiano
+    IniMemoryUsage usage = ini.memoryUsage();
+    EXPECT_EQ(usage.total.data, reference.memoryUsage().total.data);
+    EXPECT_EQ(usage.sections.at("section").data, usage.total.data);
+    EXPECT_GT(usage.total.nodes, 0);
+    EXPECT_GT(usage.total.slack, 0);    // i valori lunghi stanno sull'heap con il loro terminatore
+}
+
+TYPED_TEST(BasicIniFileTest, CommitAndDiffMatchIniFile)
+{
+    TypeParam ini;
+    IniFile reference;
+    for (int s = 0; s < 4; s++)
+    {
+        for (int k = 0; k < 20; k++)
+        {
+            ini.set("section" + to_string(s), "key" + to_string(k), to_string(k));
+            reference.set("section" + to_string(s), "key" + to_string(k), to_string(k));
+        }
+    }
+    TypeParam before(ini, ini.get_allocator());     // stesso allocatore: le sezioni restano condivise
+
+    IniTransaction transaction;
+    transaction.set("Section0", "key1", "changed").set("section0", "new", "1").deleteKey("section0", "key2")
+               .deleteSection("section1").deleteSection("section2").set("section2", "only", "1")
+               .set("section9", "b", "2").set("section9", "a", "1").deleteKey("missing", "key");
+    vector<IniChange> changes, expected;
+    ini.commit(transaction, &changes);
+    reference.commit(transaction, &expected);
+
+    auto describe = [](const vector<IniChange>& list)
+    {
+        string text;
+        for (const auto& change : list)
+            text += to_string(static_cast<int>(change.type)) + " " + change.section + "." + change.key + " " +
+                    change.oldValue + ">" + change.newValue + "\n";
+        return text;
+    };
+    EXPECT_EQ(describe(changes), describe(expected));
+    EXPECT_EQ(describe(TypeParam::diff(before, ini)), describe(expected));
+    EXPECT_EQ(ini.get("section0", "key1"), "changed");
+    EXPECT_FALSE(ini.hasSection("section1"));
+    EXPECT_EQ(ini.hasKey("key3"), vector<string>({"section0", "section3"}));
+    EXPECT_EQ(ini.sharedSections(before), 1);     // solo section3 non e' stata toccata
+}
+
+TYPED_TEST(BasicIniFileTest, InterpolationLazyCommentsAndStats)
+{
+    const string fileName = "basic_ini_features.ini";
+    {
+        ofstream file(fileName);
+        file << "; paths\n[Paths]\nRoot=/opt\n; data directory\nData=${root}/data\n[app]\nlog=${paths:data}/log\n";
+    }
+
+    TypeParam ini(fileName, IniCommentMode::Lazy);
+    remove(fileName.c_str());
+
+    EXPECT_EQ(ini.getResolved("APP", "log"), "/opt/data/log");
+    ini.set("paths", "root", "/srv");
+    EXPECT_EQ(ini.getResolved("app", "log"), "/srv/data/log");
+    EXPECT_EQ(ini.stats().resolvedValues, 3);
+
+    bool keepsComments = ini.getSectionComment("paths") == "; paths\n";
+    EXPECT_EQ(ini.getKeyComment("paths", "data"), keepsComments ? "; data directory\n" : "");
+    EXPECT_EQ(ini.memoryUsage().retainedBuffer, 0);     // il buffer trattenuto se ne va con la materializzazione
+#if INIMANAGER_STATS
+    EXPECT_EQ(ini.stats().loads, 1);
+    EXPECT_EQ(ini.stats().sets, 1);
+#endif
+}
+
+TEST(BasicIniFilePolicyTest, StatefulAllocatorKeepsEverythingInItsResource)
+{
+    // risorsa senza ripiego: ogni allocazione del file deve finire nel buffer, nessuna passa da operator new
+    vector<char> buffer(1 << 16), otherBuffer(1 << 16);
+    pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), pmr::null_memory_resource());
+    pmr::monotonic_buffer_resource otherArena(otherBuffer.data(), otherBuffer.size(), pmr::null_memory_resource());
+    using FlatIniFile = BasicIniFile<IniCaseInsensitive, IniKeepComments, IniFlatStorage>;
+
+    FlatIniFile ini(&arena);
+    const string section = "Application_Settings_Section";
+    const string key = "Connection_Timeout_Milliseconds";
+    const string value = "a value that does not fit in the small string buffer";
+    const string comment = "; a comment that does not fit in the small string buffer\n";
+    vector<string> sections, keys;
+    for (int i = 0; i < 20; i++)
+    {
+        sections.push_back(section + to_string(i % 3));
+        keys.push_back(key + to_string(i));
+    }
+    ini.hasKey(keys.back(), keys.back());      // riscaldamento del buffer di ricerca del thread, con il nome piu' lungo
+
+    AllocationCounter counter;
+    for (size_t i = 0; i < keys.size(); i++)
+        ini.set(sections[i], keys[i], value);
+    ini.setKeyComment(sections[0], keys[0], comment);
+    EXPECT_EQ(counter.allocations(), 0);
+    EXPECT_EQ(ini.resource(), &arena);
+
+    FlatIniFile copy(ini, &otherArena);     // altra risorsa: copia profonda, niente sezioni condivise
+    EXPECT_EQ(copy.sharedSections(ini), 0);
+    EXPECT_EQ(copy.print(true), ini.print(true));
+    FlatIniFile sameResource(copy, &otherArena);
+    EXPECT_EQ(sameResource.sharedSections(copy), 3);
+}
+
+TEST(BasicIniFilePolicyTest, CaseSensitiveCommitKeepsNames)
+{
+    BasicIniFile<IniCaseSensitive, IniKeepComments, IniHashStorage> ini;
+    ini.set("Network", "Port", "8080");
+
+    IniTransaction transaction;
+    transaction.set("Network", "Port", "9090").set("network", "port", "1").deleteKey("Network", "port");
+    vector<IniChange> changes;
+    ini.commit(transaction, &changes);
+
+    EXPECT_EQ(ini.get("Network", "Port"), "9090");
+    EXPECT_EQ(ini.get("network", "port"), "1");
+    ASSERT_EQ(changes.size(), 2);
+    EXPECT_EQ(changes[0].section, "Network");
+    EXPECT_EQ(changes[0].key, "Port");
+    EXPECT_EQ(changes[1].section, "network");
+}
+
+TEST(BasicIniFilePolicyTest, CaseSensitiveKeepsNamesDistinct)
+{
+    BasicIniFile<IniCaseSensitive> ini;
+    ini.set("Network", "Port", "8080");
+    ini.set("network", "port", "9090");
+
+    EXPECT_EQ(ini.get("Network", "Port"), "8080");
+    EXPECT_EQ(ini.get("network", "port"), "9090");
+    EXPECT_FALSE(ini.hasKey("NETWORK", "port"));
+    EXPECT_EQ(ini.print(false), "[Network]\nPort=8080\n[network]\nport=9090\n");
+}
+
+TEST(BasicIniFilePolicyTest, CommentsAreKeptOrDropped)
+{
+    const string fileName = "basic_ini_comments.ini";
+    {
+        ofstream file(fileName);
+        file << "; section comment\n[general]\n; key comment\nname=TestApp\n";
+    }
+
+    BasicIniFile<> keep(fileName);
+    BasicIniFile<IniCaseInsensitive, IniDropComments> drop(fileName);
+    remove(fileName.c_str());
+
+    EXPECT_EQ(keep.getSectionComment("general"), "; section comment\n");
+    EXPECT_EQ(keep.getKeyComment("general", "name"), "; key comment\n");
+    EXPECT_EQ(keep.print(true), "; section comment\n[general]\n; key comment\nname=TestApp\n");
+
+    EXPECT_EQ(drop.getSectionComment("general"), "");
+    EXPECT_FALSE(drop.setKeyComment("general", "name", "; comment\n"));
+    EXPECT_EQ(drop.print(true), "[general]\nname=TestApp\n");
+    EXPECT_LT(sizeof(drop), sizeof(keep));
+}
+
+TEST(BasicIniFilePolicyTest, AdaptiveMapMatchesMap)
+{
+    // inserimenti e cancellazioni pseudo-casuali, prima e dopo la promozione a indice hash
+    IniAdaptiveMap<string, string, allocator<pair<string, string>>, 8> adaptive;
+    map<string, string> reference;
+    uint64_t state = 1;
+    auto next = [&state]
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<size_t>(state >> 33);
+    };
+
+    for (int round = 0; round < 2000; round++)
+    {
+        string key = "key_" + to_string(next() % 300);
+        if (next() % 3 == 0)
+        {
+            auto it = adaptive.find(key);
+            EXPECT_EQ(it != adaptive.end(), reference.erase(key) == 1) << key;
+            if (it != adaptive.end())
+                adaptive.erase(it);
+        }
+        else
+        {
+            string value = to_string(round);
+            EXPECT_EQ(adaptive.insert_or_assign(key, value).second, reference.insert_or_assign(key, value).second);
+        }
+    }
+
+    EXPECT_TRUE(adaptive.hashed());
+    ASSERT_EQ(adaptive.size(), reference.size());
+    for (int i = 0; i < 300; i++)
+    {
+        string key = "key_" + to_string(i);
+        auto it = adaptive.find(key);
+        auto expected = reference.find(key);
+        ASSERT_EQ(it != adaptive.end(), expected != reference.end()) << key;
+        if (it != adaptive.end())
+        {
+            EXPECT_EQ(it->second, expected->second);
+        }
+    }
+
+    // dopo la promozione le modifiche finiscono in coda: restoreOrder rimette il vettore in ordine di nome
+    EXPECT_FALSE(adaptive.ordered());
+    adaptive.restoreOrder();
+    EXPECT_TRUE(adaptive.ordered());
+    EXPECT_TRUE(equal(adaptive.begin(), adaptive.end(), reference.begin(), reference.end(),
+                      [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+    for (const auto& item : reference)
+        EXPECT_NE(adaptive.find(item.first), adaptive.end()) << item.first;
+
+    // sotto la soglia resta un vettore ordinato
+    IniAdaptiveMap<string, string, allocator<pair<string, string>>, 8> small;
+    for (const char* key : {"c", "a", "b"})
+        small.try_emplace(key);
+    EXPECT_FALSE(small.hashed());
+    EXPECT_EQ(small.begin()->first, "a");
+}
+
+TEST(BasicIniFilePolicyTest, AdaptiveIniFilePrintsLikeIniFile)
+{
+    IniFile ini;
+    AdaptiveIniFile adaptive;
+    for (int i = 0; i < 100; i++)
+    {
+        string key = "Key" + to_string((i * 37) % 100);
+        ini.set("big", key, to_string(i));
+        adaptive.set("big", key, to_string(i));
+    }
+    for (int i = 0; i < 100; i += 3)
+    {
+        string key = "key" + to_string(i);
+        EXPECT_TRUE(ini.deleteKey("big", key));
+        EXPECT_TRUE(adaptive.deleteKey("big", key));
+    }
+
+    EXPECT_EQ(adaptive.print(true), ini.print(true));
+    EXPECT_EQ(adaptive.hasKey("key1"), ini.hasKey("key1"));
+
+    // load riordina ogni sezione una volta sola; diff non dipende dall'ordine in cui set() ha lasciato le chiavi
+    const string fileName = "adaptive_ini_file.ini";
+    adaptive.save(fileName);
+    AdaptiveIniFile loaded(fileName);
+    remove(fileName.c_str());
+    EXPECT_EQ(loaded.print(true), ini.print(true));
+
+    IniFile reference = ini;
+    for (int i = 99; i >= 0; i -= 7)
+    {
+        adaptive.set("big", "Key" + to_string(i), "changed");
+        reference.set("big", "Key" + to_string(i), "changed");
+    }
+    vector<IniChange> changes = AdaptiveIniFile::diff(loaded, adaptive);
+    vector<IniChange> expected = IniFile::diff(ini, reference);
+    ASSERT_EQ(changes.size(), expected.size());
+    for (size_t i = 0; i < changes.size(); i++)
+    {
+        EXPECT_EQ(changes[i].key, expected[i].key);
+        EXPECT_EQ(changes[i].type, expected[i].type);
+    }
+}
+
+TEST(BasicIniFilePolicyTest, SaveRoundTrip)
+{
+    const string fileName = "basic_ini_save.ini";
+    BasicIniFile<IniCaseInsensitive, IniKeepComments, IniFlatStorage> ini;
+    ini.set("b", "z", "1");
+    ini.set("a", "y", "2");
+    ini.set("a", "x", "3");
+    ini.setKeyComment("a", "x", "; first\n");
+    ini.save(fileName);
+
+    IniFile loaded(fileName);
+    remove(fileName.c_str());
+    EXPECT_EQ(loaded.print(true), "[a]\n; first\nx=3\ny=2\n[b]\nz=1\n");
+}
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include "../ChangeNotifier.h"
+#include "../ConcurrentIniFile.h"
+#include "../IniFileWatcher.h"
+
+TEST(ChangeNotifierTest, DiffReportsAddedModifiedAndRemovedKeys)
+{
+    IniFile before;
+    before.set("a", "kept", "1");
+    before.set("a", "changed", "old");
+    before.set("a", "removed", "x");
+    before.set("gone", "key", "value");
+
+    IniFile after;
+    after.set("a", "kept", "1");
+    after.set("a", "changed", "new");
+    after.set("a", "added", "y");
+    after.set("new", "key", "value");
+
+    vector<IniChange> changes = IniFile::diff(before, after);
+    ASSERT_EQ(changes.size(), 5);
+
+    EXPECT_EQ(changes[0].type, IniChange::Type::Added);
+    EXPECT_EQ(changes[0].key, "added");
+    EXPECT_EQ(changes[1].type, IniChange::Type::Modified);
+    EXPECT_EQ(changes[1].oldValue, "old");
+    EXPECT_EQ(changes[1].newValue, "new");
+    EXPECT_EQ(changes[2].type, IniChange::Type::Removed);
+    EXPECT_EQ(changes[2].key, "removed");
+    EXPECT_EQ(changes[3].type, IniChange::Type::Removed);
+    EXPECT_EQ(changes[3].section, "gone");
+    EXPECT_EQ(changes[4].type, IniChange::Type::Added);
+    EXPECT_EQ(changes[4].section, "new");
+
+    EXPECT_TRUE(IniFile::diff(after, after).empty());
+}
+
+TEST(ChangeNotifierTest, SubscriptionsReceiveFilteredBatches)
+{
+    ChangeNotifier notifier;
+    EXPECT_TRUE(notifier.empty());
+
+    vector<IniChange> all, section, key;
+    notifier.subscribe([&all](const vector<IniChange>& batch) { all = batch; });
+    notifier.subscribeSection("Network", [&section](const vector<IniChange>& batch) { section = batch; });
+    size_t keyId = notifier.subscribeKey("NETWORK", "Port", [&key](const vector<IniChange>& batch) { key = batch; });
+
+    notifier.publish({{IniChange::Type::Added, "general", "name", "", "app"},
+                      {IniChange::Type::Modified, "network", "host", "a", "b"},
+                      {IniChange::Type::Modified, "network", "port", "80", "8080"}});
+
+    EXPECT_EQ(all.size(), 3);
+    EXPECT_EQ(section.size(), 2);
+    ASSERT_EQ(key.size(), 1);
+    EXPECT_EQ(key[0].newValue, "8080");
+
+    EXPECT_TRUE(notifier.unsubscribe(keyId));
+    EXPECT_FALSE(notifier.unsubscribe(keyId));
+    key.clear();
+    notifier.publish({{IniChange::Type::Removed, "network", "port", "8080", ""}});
+    EXPECT_TRUE(key.empty());
+}
+
+TEST(ChangeNotifierTest, SerialExecutorDeliversOutsideTheWriter)
+{
+    SerialExecutor executor;
+    ConcurrentIniFile iniFile;
+
+    thread::id writer = this_thread::get_id();
+    thread::id deliveredOn;
+    vector<IniChange> received;
+    iniFile.notifier().subscribeKey("section", "key", [&](const vector<IniChange>& batch)
+    {
+        deliveredOn = this_thread::get_id();
+        received.insert(received.end(), batch.begin(), batch.end());
+    }, executor.executor());
+
+    iniFile.set("section", "key", "one");
+    iniFile.set("section", "key", "one");   // valore invariato: nessuna notifica
+    iniFile.set("section", "key", "two");
+    iniFile.set("section", "other", "ignored");
+    iniFile.deleteSection("section");
+    executor.drain();
+
+    ASSERT_EQ(received.size(), 3);
+    EXPECT_EQ(received[0].type, IniChange::Type::Added);
+    EXPECT_EQ(received[1].type, IniChange::Type::Modified);
+    EXPECT_EQ(received[1].oldValue, "one");
+    EXPECT_EQ(received[2].type, IniChange::Type::Removed);
+    EXPECT_EQ(received[2].oldValue, "two");
+    EXPECT_NE(deliveredOn, writer);
+}
+
+TEST(ChangeNotifierTest, WatcherPublishesReloadDiff)
+{
+    const string testFileName = "test_notifier_reload.ini";
+    {
+        ofstream file(testFileName);
+        file << "[section]\nkey=value\nother=1\n";
+    }
+
+    IniFileWatcher watcher(testFileName, chrono::milliseconds(20));
+    watcher.stop();
+
+    vector<IniChange> received;
+    watcher.notifier().subscribeSection("section", [&received](const vector<IniChange>& batch) { received = batch; });
+
+    {
+        ofstream file(testFileName);
+        file << "[section]\nkey=changed value\n";
+    }
+    EXPECT_TRUE(watcher.reloadIfChanged());
+
+    ASSERT_EQ(received.size(), 2);
+    EXPECT_EQ(received[0].type, IniChange::Type::Modified);
+    EXPECT_EQ(received[0].newValue, "changed value");
+    EXPECT_EQ(received[1].type, IniChange::Type::Removed);
+    EXPECT_EQ(received[1].key, "other");
+
+    remove(testFileName.c_str());
+}
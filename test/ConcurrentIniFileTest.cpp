@@ -0,0 +1,199 @@
+#include <thread>
+#include "gtest/gtest.h"
+#include "../ConcurrentIniFile.h"
+#include "../IniTransaction.h"
+
+TEST(ConcurrentIniFileTest, SetAndGetValues)
+{
+    ConcurrentIniFile iniFile;
+    iniFile.set("Section", "Key", "value");
+    EXPECT_EQ(iniFile.get("section", "key"), "value");
+    EXPECT_TRUE(iniFile.hasSection("SECTION"));
+    EXPECT_TRUE(iniFile.hasKey("section", "KEY"));
+    EXPECT_TRUE(iniFile.get("section", "missing").empty());
+}
+
+TEST(ConcurrentIniFileTest, AddAndDeleteSectionsAndKeys)
+{
+    ConcurrentIniFile iniFile;
+    iniFile.addSection("section");
+    iniFile.set("section", "key", "value");
+    iniFile.set("other", "key", "value");
+
+    vector<string> expectedSections = {"other", "section"};
+    EXPECT_EQ(iniFile.hasKey("key"), expectedSections);
+
+    EXPECT_TRUE(iniFile.deleteKey("section", "key"));
+    EXPECT_FALSE(iniFile.deleteKey("section", "key"));
+    EXPECT_TRUE(iniFile.deleteSection("section"));
+    EXPECT_FALSE(iniFile.deleteSection("section"));
+    EXPECT_FALSE(iniFile.hasSection("section"));
+}
+
+TEST(ConcurrentIniFileTest, SaveAndLoadKeepsComments)
+{
+    const string testFileName = "test_concurrent.ini";
+
+    ofstream file(testFileName);
+    file << "; section comment\n[section]\n; key comment\nkey=value\n";
+    file.close();
+
+    ConcurrentIniFile iniFile(testFileName);
+    EXPECT_EQ(iniFile.get("section", "key"), "value");
+
+    iniFile.set("section", "other", "value2");
+    iniFile.save();
+
+    IniFile loaded(testFileName);
+    EXPECT_EQ(loaded.get("section", "other"), "value2");
+    EXPECT_EQ(loaded.getSectionComment("section"), "; section comment\n");
+    EXPECT_EQ(loaded.getKeyComment("section", "key"), "; key comment\n");
+
+    remove(testFileName.c_str());
+}
+
+TEST(ConcurrentIniFileTest, LoadKeepsCommentsOfSectionsWithoutKeys)
+{
+    const string testFileName = "test_concurrent_empty.ini";
+
+    ofstream file(testFileName);
+    file << "; empty comment\n[empty]\n; section comment\n[section]\nkey=value\n";
+    file.close();
+
+    ConcurrentIniFile iniFile(testFileName);
+    IniFile expected(testFileName);
+    EXPECT_FALSE(iniFile.hasSection("empty"));      // come IniFile, la sezione nasce con la prima chiave
+    EXPECT_EQ(iniFile.snapshot().getSectionComment("empty"), "; empty comment\n");
+
+    iniFile.set("empty", "key", "value");
+    expected.set("empty", "key", "value");
+    EXPECT_EQ(iniFile.snapshot().print(true), expected.print(true));
+
+    remove(testFileName.c_str());
+}
+
+TEST(ConcurrentIniFileTest, CommitErasesCommentsOfDeletedKeys)
+{
+    const string testFileName = "test_concurrent_commit.ini";
+
+    ofstream file(testFileName);
+    file << "[section]\n; first\nfirst=1\n; second\nsecond=2\n[replaced]\n; old\nold=1\n; kept\nkept=1\n";
+    file.close();
+
+    ConcurrentIniFile iniFile(testFileName);
+    IniTransaction transaction;
+    transaction.deleteKey("section", "first").deleteSection("replaced").set("replaced", "kept", "2");
+    iniFile.commit(transaction);
+
+    iniFile.set("section", "first", "again");
+    iniFile.set("replaced", "old", "again");
+    IniFile snapshot = iniFile.snapshot();
+    EXPECT_EQ(snapshot.getKeyComment("section", "first"), "");
+    EXPECT_EQ(snapshot.getKeyComment("section", "second"), "; second\n");
+    EXPECT_EQ(snapshot.getKeyComment("replaced", "old"), "");
+    EXPECT_EQ(snapshot.getKeyComment("replaced", "kept"), "; kept\n");
+
+    remove(testFileName.c_str());
+}
+
+TEST(ConcurrentIniFileTest, NotificationsFollowTheOrderOfTheWrites)
+{
+    ConcurrentIniFile iniFile;
+    mutex receivedMutex;
+    vector<IniChange> received;
+    iniFile.notifier().subscribeKey("section", "key", [&](const vector<IniChange>& batch)
+    {
+        lock_guard<mutex> lock(receivedMutex);
+        received.insert(received.end(), batch.begin(), batch.end());
+    });
+
+    const int threadCount = 4;
+    const int writes = 2000;
+    vector<thread> threads;
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&iniFile, t]
+        {
+            for (int i = 0; i < writes; i++)
+            {
+                if (i % 2 == 0)
+                {
+                    iniFile.set("section", "key", to_string(t) + ":" + to_string(i));
+                }
+                else
+                {
+                    IniTransaction transaction;
+                    transaction.set("section", "key", to_string(t) + ":" + to_string(i));
+                    iniFile.commit(transaction);
+                }
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    // ogni notifica parte dal valore lasciato dalla precedente
+    ASSERT_EQ(received.size(), threadCount * writes);
+    for (size_t i = 1; i < received.size(); i++)
+        ASSERT_EQ(received[i].oldValue, received[i - 1].newValue) << "notification " << i;
+    EXPECT_EQ(received.back().newValue, iniFile.get("section", "key"));
+}
+
+TEST(ConcurrentIniFileTest, CallbacksCanWriteToTheFile)
+{
+    ConcurrentIniFile iniFile;
+    vector<string> order;
+    iniFile.notifier().subscribe([&](const vector<IniChange>& batch)
+    {
+        for (const auto& change : batch)
+        {
+            order.push_back(change.key);
+            if (change.key == "trigger")
+                iniFile.set("section", "derived", change.newValue + "!");
+        }
+    });
+
+    iniFile.set("section", "trigger", "value");
+    EXPECT_EQ(iniFile.get("section", "derived"), "value!");
+    EXPECT_EQ(order, vector<string>({"trigger", "derived"}));
+}
+
+TEST(ConcurrentIniFileTest, ParallelWritesToDifferentSections)
+{
+    ConcurrentIniFile iniFile;
+    const int threadCount = 8;
+    const int writes = 1000;
+
+    vector<thread> threads;
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&iniFile, t]
+        {
+            string section = "worker" + to_string(t);
+            for (int i = 0; i < writes; i++)
+            {
+                iniFile.set(section, "counter", to_string(i));
+                iniFile.set(section, "key" + to_string(i % 10), "value");
+            }
+        });
+    }
+
+    // nel frattempo un altro thread modifica la struttura del file
+    thread structural([&iniFile]
+    {
+        for (int i = 0; i < writes; i++)
+        {
+            iniFile.addSection("temporary");
+            iniFile.deleteSection("temporary");
+        }
+    });
+
+    for (auto& t : threads)
+        t.join();
+    structural.join();
+
+    for (int t = 0; t < threadCount; t++)
+        EXPECT_EQ(iniFile.get("worker" + to_string(t), "counter"), to_string(writes - 1));
+    EXPECT_EQ(iniFile.snapshot().hasKey("key9").size(), threadCount);
+    EXPECT_FALSE(iniFile.hasSection("temporary"));
+}
@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "../ConstexprIniFile.h"
+
+// Compilato solo con -DINIMANAGER_CXX20=ON
+
+#ifdef INIMANAGER_HAS_CONSTEXPR_INI
+
+using Defaults = ConstexprIniFile<R"(; impostazioni predefinite
+[General]
+name=TestApp
+version=1.0
+[network]
+port=8080
+Host=localhost
+port=9090
+[empty]
+)">;
+
+static_assert(Defaults::size() == 4);
+static_assert(Defaults::at("general", "NAME") == "TestApp");
+static_assert(Defaults::at("network", "port") == "9090");      // vince l'ultima occorrenza, come in IniFile::load
+static_assert(Defaults::get("network", "missing").empty());
+static_assert(Defaults::hasKey("NETWORK", "host"));
+static_assert(Defaults::hasSection("general"));
+static_assert(!Defaults::hasSection("empty"));
+
+TEST(ConstexprIniFileTest, TableIsSortedAndComplete)
+{
+    constexpr auto entries = Defaults::entries();
+    ASSERT_EQ(entries.size(), 4);
+    EXPECT_EQ(entries[0].key, "name");
+    EXPECT_EQ(entries[1].key, "version");
+    EXPECT_EQ(entries[2].key, "Host");
+    EXPECT_EQ(entries[3].key, "port");
+}
+
+TEST(ConstexprIniFileTest, MatchesIniFileLoad)
+{
+    using Crlf = ConstexprIniFile<"k=top\r\n[A]\r\nx=1\r\nno equals\r\ny=a=b\r\n">;
+    IniFile ini = Crlf::toIniFile();
+
+    EXPECT_EQ(ini.get("", "k"), "top");
+    EXPECT_EQ(ini.get("a", "x"), "1");
+    EXPECT_EQ(ini.get("a", "y"), "a=b");
+    EXPECT_FALSE(ini.hasKey("a", "no equals"));
+    EXPECT_EQ(Crlf::size(), 3);
+}
+
+TEST(ConstexprIniFileTest, EmptyLiteral)
+{
+    using Empty = ConstexprIniFile<"">;
+    EXPECT_EQ(Empty::size(), 0);
+    EXPECT_EQ(Empty::get("a", "b"), "");
+}
+
+#endif
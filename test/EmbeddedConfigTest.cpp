@@ -0,0 +1,38 @@
+#include <type_traits>
+#include "gtest/gtest.h"
+#include "../IniFile.h"
+#include "embedded_test.h"
+#include "embedded_edge.h"
+
+// embedded_test.h e' generato da iniFiles/test.ini con inimanager_embed (vedi test/CMakeLists.txt)
+
+static_assert(embedded_test::network::port == 8080);
+static_assert(std::is_same_v<decltype(embedded_test::network::port), const std::int64_t>);
+static_assert(embedded_test::general::version == 1.0);
+static_assert(embedded_test::general::name == "TestApp");
+static_assert(embedded_test::get("NETWORK", "Host") == "localhost");
+static_assert(embedded_test::hasKey("general", "version"));
+static_assert(!embedded_test::hasKey("general", "missing"));
+
+// embedded_edge.h: una chiave con il nome della sezione e valori con zeri iniziali, che restano stringhe
+static_assert(embedded_edge::mode::mode_2 == "0755");
+static_assert(std::is_same_v<decltype(embedded_edge::mode::padded), const std::string_view>);
+static_assert(embedded_edge::mode::zero == 0);
+static_assert(embedded_edge::mode::real == 0.5);
+
+TEST(EmbeddedConfigTest, MatchesIniFile)
+{
+    IniFile ini;
+    ini.load(string(embedded_test::source));
+
+    ASSERT_EQ(embedded_test::entryCount, 4);
+    for (const auto& entry : embedded_test::entries)
+        EXPECT_EQ(ini.get(string(entry.section), string(entry.key)), entry.value);
+}
+
+TEST(EmbeddedConfigTest, MissingEntriesAreEmpty)
+{
+    EXPECT_EQ(embedded_test::get("general", "port"), "");
+    EXPECT_EQ(embedded_test::get("missing", "name"), "");
+    EXPECT_FALSE(embedded_test::hasKey("", ""));
+}
@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../IniCorpus.h"
+#include "../IniFile.h"
+
+static IniCorpusOptions corpusOptions()
+{
+    IniCorpusOptions options;
+    options.seed = 42;
+    options.sections = 20;
+    options.keysPerSection = 50;
+    options.commentRatio = 0.2;
+    options.longLineRatio = 0.05;
+    options.longLineSize = 10000;
+    options.caseVariation = true;
+    return options;
+}
+
+static string corpusText(const IniCorpusOptions& options)
+{
+    ostringstream out;
+    IniCorpus(options).write(out);
+    return out.str();
+}
+
+static void expectCorpus(const IniCorpus& corpus, const IniCorpusOptions& options, const IniFile& ini)
+{
+    for (size_t s = 0; s < options.sections; s++)
+    {
+        ASSERT_TRUE(ini.hasSection(corpus.sectionName(s)));
+        for (size_t k = 0; k < options.keysPerSection; k++)
+            ASSERT_EQ(ini.get(corpus.sectionName(s), corpus.keyName(s, k)), corpus.value(s, k));
+    }
+}
+
+TEST(IniCorpusTest, SameSeedSameBytes)
+{
+    IniCorpusOptions options = corpusOptions();
+    EXPECT_EQ(corpusText(options), corpusText(options));
+
+    IniCorpusOptions other = options;
+    other.seed = 43;
+    EXPECT_NE(corpusText(options), corpusText(other));
+}
+
+TEST(IniCorpusTest, WriteReturnsSizeCloseToEstimate)
+{
+    IniCorpusOptions options = corpusOptions();
+    options.sections = 200;
+    options.longLineRatio = 0;
+    string text = corpusText(options);
+
+    IniCorpus corpus(options);
+    ostringstream out;
+    EXPECT_EQ(corpus.write(out), text.size());
+    EXPECT_NEAR(static_cast<double>(text.size()), static_cast<double>(corpus.estimatedSize()), text.size() * 0.1);
+
+    IniCorpusOptions sized = IniCorpus::forTargetSize(1 << 20, options);
+    EXPECT_NEAR(static_cast<double>(corpusText(sized).size()), 1 << 20, (1 << 20) * 0.1);
+}
+
+TEST(IniCorpusTest, LoadMatchesGeneratedValues)
+{
+    IniCorpusOptions options = corpusOptions();
+    IniCorpus corpus(options);
+    const string fileName = "corpus_test.ini";
+    corpus.write(fileName);
+
+    IniFile ini;
+    ini.load(fileName);
+    expectCorpus(corpus, options, ini);
+
+    // il salvataggio normalizza i nomi, ma i valori restano identici
+    ini.save(fileName);
+    IniFile reloaded;
+    reloaded.load(fileName);
+    expectCorpus(corpus, options, reloaded);
+
+    remove(fileName.c_str());
+}
+
+TEST(IniCorpusTest, CrlfLoadsLikeLf)
+{
+    IniCorpusOptions options = corpusOptions();
+    IniCorpusOptions crlfOptions = options;
+    crlfOptions.crlf = true;
+    IniCorpus(options).write("corpus_lf.ini");
+    IniCorpus(crlfOptions).write("corpus_crlf.ini");
+
+    IniFile lf;
+    lf.load("corpus_lf.ini");
+    IniFile crlf;
+    crlf.load("corpus_crlf.ini");
+
+    EXPECT_TRUE(IniFile::diff(lf, crlf).empty());
+    EXPECT_EQ(lf.print(true), crlf.print(true));
+
+    remove("corpus_lf.ini");
+    remove("corpus_crlf.ini");
+}
+
+TEST(IniCorpusTest, EmptyValuesWithZeroMinimum)
+{
+    IniCorpusOptions options;
+    options.minValueSize = 0;
+    options.maxValueSize = 1;
+    IniCorpus corpus(options);
+
+    size_t empty = 0;
+    for (size_t s = 0; s < options.sections; s++)
+    {
+        for (size_t k = 0; k < options.keysPerSection; k++)
+            empty += corpus.value(s, k).empty();
+    }
+    EXPECT_GT(empty, 0);
+    EXPECT_FALSE(corpusText(options).empty());
+}
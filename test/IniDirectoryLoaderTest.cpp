@@ -0,0 +1,72 @@
+#include <filesystem>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "../IniDirectoryLoader.h"
+
+class IniDirectoryLoaderTest : public ::testing::Test
+{
+    protected:
+        const string directory = "test_conf.d";
+
+        void SetUp() override
+        {
+            filesystem::remove_all(directory);
+            filesystem::create_directory(directory);
+        }
+
+        void TearDown() override
+        {
+            filesystem::remove_all(directory);
+        }
+
+        void write(const string& name, const string& content) const
+        {
+            ofstream file(directory + "/" + name);
+            file << content;
+        }
+};
+
+TEST_F(IniDirectoryLoaderTest, MergesInLexicalOrder)
+{
+    write("20-site.ini", "[network]\nport=9090\n; site comment\n[site]\nname=eu\n");
+    write("10-defaults.ini", "[network]\nhost=localhost\nport=8080\n[logging]\nlevel=info\n");
+    write("30-host.ini", "[Logging]\nLevel=debug\n");
+    write("README", "[ignored]\nkey=value\n");
+    write(".hidden.ini", "[ignored]\nkey=value\n");
+
+    vector<IniFragmentTiming> timings;
+    IniFile merged = IniDirectoryLoader(4).load(directory, "*.ini", &timings);
+
+    EXPECT_EQ(merged.get("network", "host"), "localhost");
+    EXPECT_EQ(merged.get("network", "port"), "9090");
+    EXPECT_EQ(merged.get("logging", "level"), "debug");
+    EXPECT_EQ(merged.get("site", "name"), "eu");
+    EXPECT_EQ(merged.getSectionComment("site"), "; site comment\n");
+    EXPECT_FALSE(merged.hasSection("ignored"));
+
+    ASSERT_EQ(timings.size(), 3);
+    EXPECT_EQ(filesystem::path(timings[0].fileName).filename(), "10-defaults.ini");
+    EXPECT_EQ(filesystem::path(timings[2].fileName).filename(), "30-host.ini");
+    EXPECT_EQ(timings[2].bytes, string("[Logging]\nLevel=debug\n").size());
+    EXPECT_GT(timings[0].loadTime.count(), 0);
+}
+
+TEST_F(IniDirectoryLoaderTest, ResultDoesNotDependOnThreadCount)
+{
+    for (int i = 0; i < 50; i++)
+        write("fragment" + string(i < 10 ? "0" : "") + to_string(i) + ".conf",
+              "[shared]\nlast=" + to_string(i) + "\n[own" + to_string(i) + "]\nkey=value\n");
+
+    IniFile serial = IniDirectoryLoader(1).load(directory, "*.conf");
+    IniFile parallel = IniDirectoryLoader(8).load(directory, "*.conf");
+
+    EXPECT_EQ(serial.get("shared", "last"), "49");
+    EXPECT_EQ(serial.print(true), parallel.print(true));
+    EXPECT_EQ(IniDirectoryLoader::list(directory, "fragment0*").size(), 10);
+}
+
+TEST_F(IniDirectoryLoaderTest, ReportsErrors)
+{
+    EXPECT_THROW(IniDirectoryLoader().load("missing_conf.d"), runtime_error);
+    EXPECT_EQ(IniDirectoryLoader().load(directory).print(true), "");
+}
@@ -84,6 +84,111 @@ TEST(IniFileTest, HandleEmptyLinesAndComments)
     remove(testFileName.c_str());
 }
 
+TEST(IniFileTest, SkipCommentsOnLoad)
+{
+    const string testFileName = "test_skip_comments.ini";
+
+    ofstream file(testFileName);
+    file << "; section comment\n[section]\n; key comment\nkey=value\n;trailing comment\n";
+    file.close();
+
+    IniFile iniFile(testFileName, IniFile::CommentMode::Skip);
+    EXPECT_EQ(iniFile.get("section", "key"), "value");
+    EXPECT_TRUE(iniFile.getSectionComment("section").empty());
+    EXPECT_TRUE(iniFile.getKeyComment("section", "key").empty());
+    EXPECT_EQ(iniFile.print(true), "[section]\nkey=value\n");
+
+    IniFile kept(testFileName);
+    EXPECT_EQ(kept.getKeyComment("section", "key"), "; key comment\n");
+
+    remove(testFileName.c_str());
+}
+
+TEST(IniFileTest, LazyCommentsMatchKeptComments)
+{
+    const string testFileName = "test_lazy_comments.ini";
+
+    ofstream file(testFileName, ios::binary);
+    file << "; first line\r\n\r\n; second line\r\n[Section]\r\n; key comment\r\nKey=value\r\n"
+            "other=1\r\n; overridden\r\n[section]\r\n; last\r\nkey=new\r\n; trailing\r\n";
+    file.close();
+
+    IniFile kept(testFileName);
+    IniFile lazy(testFileName, IniFile::CommentMode::Lazy);
+    IniFile copy = lazy;    // la copia condivide il buffer e materializza per conto suo
+
+    EXPECT_EQ(lazy.get("section", "key"), "new");
+    EXPECT_EQ(lazy.getSectionComment("SECTION"), kept.getSectionComment("section"));
+    EXPECT_EQ(lazy.getKeyComment("section", "key"), "; last\n");
+    EXPECT_EQ(lazy.print(true), kept.print(true));
+    EXPECT_EQ(copy.print(true), kept.print(true));
+
+    IniFile edited(testFileName, IniFile::CommentMode::Lazy);
+    EXPECT_TRUE(edited.setKeyComment("section", "other", "; edited\n"));
+    EXPECT_EQ(edited.getKeyComment("section", "other"), "; edited\n");
+    EXPECT_EQ(edited.getKeyComment("section", "key"), "; last\n");
+
+    remove(testFileName.c_str());
+}
+
+TEST(IniFileTest, MemoryResource)
+{
+    pmr::monotonic_buffer_resource arena;
+    IniFile iniFile(&arena);
+    iniFile.set("Section", "Key", "value");
+    iniFile.set("other", "key", "1");
+    iniFile.setKeyComment("section", "key", "; comment\n");
+    EXPECT_EQ(iniFile.resource(), &arena);
+
+    IniFile moved(IniFile(iniFile, pmr::new_delete_resource()));
+    EXPECT_EQ(moved.resource(), pmr::new_delete_resource());
+    EXPECT_EQ(moved.print(true), iniFile.print(true));
+
+    IniFile copy = iniFile;     // come i contenitori pmr, la copia torna alla risorsa predefinita
+    EXPECT_EQ(copy.resource(), pmr::get_default_resource());
+    EXPECT_EQ(copy.get("section", "key"), "value");
+
+    pmr::monotonic_buffer_resource output;
+    IniFile::String printed = iniFile.print(true, &output);
+    EXPECT_EQ(printed.get_allocator().resource(), &output);
+    EXPECT_EQ(string_view(printed), iniFile.print(true));
+    pmr::vector<IniFile::String> sections = iniFile.hasKey("key", &output);
+    ASSERT_EQ(sections.size(), 2);
+    EXPECT_EQ(sections[0], "other");
+    EXPECT_EQ(sections[1].get_allocator().resource(), &output);
+}
+
+TEST(IniFileTest, MemoryUsage)
+{
+    const string testFileName = "test_memory_usage.ini";
+    {
+        ofstream file(testFileName);
+        file << "; comment\n[Section]\nkey=value\n[other]\nlong=" << string(100, 'x') << "\n";
+    }
+
+    IniFile iniFile(testFileName);
+    IniMemoryUsage usage = iniFile.memoryUsage();
+    ASSERT_EQ(usage.sections.size(), 2);
+    EXPECT_EQ(usage.sections.at("section").data, string("section" "key" "value").size());
+    EXPECT_EQ(usage.sections.at("section").comments, string("section" "; comment\n").size());
+    EXPECT_EQ(usage.sections.at("section").slack, 0);       // stringhe corte: tutto dentro i nodi
+    EXPECT_EQ(usage.sections.at("other").slack, 1);         // solo il terminatore del valore lungo
+    EXPECT_EQ(usage.total.data, usage.sections.at("section").data + usage.sections.at("other").data);
+    EXPECT_EQ(usage.retainedBuffer, 0);
+    EXPECT_GT(usage.total.nodes, usage.total.data);         // con valori piccoli pesano i nodi
+
+    // con CommentMode::Lazy il buffer resta in memoria finche' i commenti non vengono letti
+    IniFile lazy(testFileName, IniFile::CommentMode::Lazy);
+    IniMemoryUsage pending = lazy.memoryUsage();
+    EXPECT_GT(pending.retainedBuffer, 0);
+    EXPECT_EQ(pending.total.data, usage.total.data);
+    lazy.getSectionComment("section");
+    EXPECT_EQ(lazy.memoryUsage().retainedBuffer, 0);
+    EXPECT_EQ(lazy.memoryUsage().total.comments, usage.total.comments);
+
+    remove(testFileName.c_str());
+}
+
 TEST(IniFileTest, CaseInsensitiveKeys)
 {
     IniFile iniFile;
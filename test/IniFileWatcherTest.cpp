@@ -0,0 +1,146 @@
+#include <filesystem>
+#include <thread>
+#include "gtest/gtest.h"
+#include "../IniFileWatcher.h"
+#include "../IniTracer.h"
+
+static void writeFile(const string& name, const string& content)
+{
+    ofstream file(name);
+    file << content;
+}
+
+static bool waitForReloads(const IniFileWatcher& watcher, uint64_t count)
+{
+    for (int i = 0; i < 200 && watcher.reloadCount() < count; i++)
+        this_thread::sleep_for(chrono::milliseconds(10));
+
+    return watcher.reloadCount() >= count;
+}
+
+TEST(IniFileWatcherTest, ReloadsAfterWrite)
+{
+    const string testFileName = "test_watcher_write.ini";
+    writeFile(testFileName, "[section]\nkey=value\n");
+
+    IniFileWatcher watcher(testFileName, chrono::milliseconds(20));
+    auto before = watcher.current();
+    EXPECT_EQ(before->get("section", "key"), "value");
+
+    writeFile(testFileName, "[section]\nkey=changed\n");
+    ASSERT_TRUE(waitForReloads(watcher, 1));
+
+    EXPECT_EQ(watcher.current()->get("section", "key"), "changed");
+    EXPECT_EQ(before->get("section", "key"), "value");  // chi teneva la vecchia versione non vede modifiche
+
+    watcher.stop();
+    remove(testFileName.c_str());
+}
+
+TEST(IniFileWatcherTest, ReloadsAfterRename)
+{
+    const string testFileName = "test_watcher_rename.ini";
+    const string tempFileName = "test_watcher_rename.ini.tmp";
+    writeFile(testFileName, "[section]\nkey=value\n");
+
+    IniFileWatcher watcher(testFileName, chrono::milliseconds(20));
+
+    writeFile(tempFileName, "[section]\nkey=renamed\n");
+    filesystem::rename(tempFileName, testFileName);
+    ASSERT_TRUE(waitForReloads(watcher, 1));
+
+    EXPECT_EQ(watcher.current()->get("section", "key"), "renamed");
+
+    watcher.stop();
+    remove(testFileName.c_str());
+}
+
+TEST(IniFileWatcherTest, SkipsReloadWhenContentIsUnchanged)
+{
+    const string testFileName = "test_watcher_unchanged.ini";
+    writeFile(testFileName, "[section]\nkey=value\n");
+
+    IniFileWatcher watcher(testFileName, chrono::milliseconds(20));
+    auto before = watcher.current();
+
+    writeFile(testFileName, "[section]\nkey=value\n");
+    EXPECT_FALSE(watcher.reloadIfChanged());
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    EXPECT_EQ(watcher.reloadCount(), 0);
+    EXPECT_EQ(watcher.current(), before);
+
+    watcher.stop();
+    remove(testFileName.c_str());
+}
+
+TEST(IniFileWatcherTest, CallbackReceivesBothVersions)
+{
+    const string testFileName = "test_watcher_callback.ini";
+    writeFile(testFileName, "[section]\nkey=old\n");
+
+    IniFileWatcher watcher(testFileName, chrono::milliseconds(20));
+
+    string oldValue, newValue;
+    watcher.onReload([&](const shared_ptr<const IniFile>& previous, const shared_ptr<const IniFile>& current)
+    {
+        oldValue = previous->get("section", "key");
+        newValue = current->get("section", "key");
+    });
+
+    watcher.stop();     // il reload manuale funziona anche senza il thread di controllo
+    writeFile(testFileName, "[section]\nkey=new value\n");
+    EXPECT_TRUE(watcher.reloadIfChanged());
+
+    EXPECT_EQ(oldValue, "old");
+    EXPECT_EQ(newValue, "new value");
+
+    remove(testFileName.c_str());
+}
+
+// riscrive il file appena il load del costruttore lo ha letto, prima che il watcher ne prenda l'impronta
+class RewriteAfterReadTracer : public IniTracer
+{
+    public:
+        explicit RewriteAfterReadTracer(string name) : fileName(std::move(name)) {}
+
+        void beginSpan(const char*) override
+        {
+        }
+
+        void endSpan(const char* name) override
+        {
+            if (!rewritten && string(name) == "load.read")
+            {
+                rewritten = true;
+                writeFile(fileName, "[section]\nkey=rewritten during load\n");
+            }
+        }
+
+    private:
+        string fileName;
+        bool rewritten = false;
+};
+
+TEST(IniFileWatcherTest, ReloadsWhenFileChangesDuringInitialLoad)
+{
+    const string testFileName = "test_watcher_initial_load.ini";
+    writeFile(testFileName, "[section]\nkey=value\n");
+
+    RewriteAfterReadTracer tracer(testFileName);
+    IniTracer::install(&tracer);
+    IniFileWatcher watcher(testFileName, chrono::milliseconds(20));
+    IniTracer::uninstall();
+    EXPECT_EQ(watcher.current()->get("section", "key"), "value");
+
+    ASSERT_TRUE(waitForReloads(watcher, 1));
+    EXPECT_EQ(watcher.current()->get("section", "key"), "rewritten during load");
+
+    watcher.stop();
+    remove(testFileName.c_str());
+}
+
+TEST(IniFileWatcherTest, MissingFileThrows)
+{
+    EXPECT_THROW(IniFileWatcher watcher("non_existent_watched_file.ini"), runtime_error);
+}
@@ -0,0 +1,123 @@
+#include <cstdlib>
+#include "gtest/gtest.h"
+#include "../IniFile.h"
+#include "../IniTransaction.h"
+
+class IniInterpolationTest : public ::testing::Test
+{
+    protected:
+        IniFile iniFile;
+
+        void SetUp() override
+        {
+            iniFile.set("paths", "base", "/opt/app");
+            iniFile.set("paths", "logs", "${base}/logs");
+            iniFile.set("paths", "archive", "${paths:logs}/archive");
+            iniFile.set("Network", "host", "example.org");
+            iniFile.set("service", "url", "https://${network:HOST}:${port}/");
+            iniFile.set("service", "port", "8443");
+            iniFile.set("other", "plain", "no references");
+        }
+};
+
+TEST_F(IniInterpolationTest, ResolvesReferences)
+{
+    EXPECT_EQ(iniFile.getResolved("paths", "logs"), "/opt/app/logs");
+    EXPECT_EQ(iniFile.getResolved("Paths", "Archive"), "/opt/app/logs/archive");
+    EXPECT_EQ(iniFile.getResolved("service", "url"), "https://example.org:8443/");
+    EXPECT_EQ(iniFile.get("paths", "logs"), "${base}/logs");    // get restituisce il valore grezzo
+}
+
+TEST_F(IniInterpolationTest, EnvironmentEscapesAndMissingKeys)
+{
+    setenv("INIMANAGER_TEST_HOME", "/home/test", 1);
+    iniFile.set("env", "home", "${ENV:INIMANAGER_TEST_HOME}/.config");
+    iniFile.set("env", "price", "$$5 and $ alone and ${unterminated");
+    iniFile.set("env", "missing", "[${nosuchkey}]");
+
+    EXPECT_EQ(iniFile.getResolved("env", "home"), "/home/test/.config");
+    EXPECT_EQ(iniFile.getResolved("env", "price"), "$5 and $ alone and ${unterminated");
+    EXPECT_EQ(iniFile.getResolved("env", "missing"), "[]");
+
+    iniFile.set("env", "nosuchkey", "now defined");
+    EXPECT_EQ(iniFile.getResolved("env", "missing"), "[now defined]");
+    unsetenv("INIMANAGER_TEST_HOME");
+}
+
+TEST_F(IniInterpolationTest, SetInvalidatesOnlyDependents)
+{
+    iniFile.getResolved("paths", "archive");
+    iniFile.getResolved("service", "url");
+    iniFile.getResolved("other", "plain");
+    EXPECT_EQ(iniFile.stats().resolvedValues, 7);
+
+    // archive dipende da logs, che dipende da base: le altre quattro voci restano in cache
+    iniFile.set("paths", "base", "/srv/app");
+    EXPECT_EQ(iniFile.stats().resolvedValues, 4);
+    EXPECT_EQ(iniFile.getResolved("paths", "archive"), "/srv/app/logs/archive");
+
+    iniFile.deleteKey("service", "port");
+    EXPECT_EQ(iniFile.getResolved("service", "url"), "https://example.org:/");
+
+    IniTransaction transaction;
+    transaction.set("network", "host", "example.com");
+    iniFile.commit(transaction);
+    EXPECT_EQ(iniFile.getResolved("service", "url"), "https://example.com:/");
+
+    iniFile.deleteSection("network");
+    EXPECT_EQ(iniFile.getResolved("service", "url"), "https://:/");
+}
+
+TEST_F(IniInterpolationTest, CyclesAreDetectedOnce)
+{
+    iniFile.set("cycle", "a", "${b}");
+    iniFile.set("cycle", "b", "x${cycle:a}");
+    iniFile.set("cycle", "user", "${a}");
+
+    EXPECT_THROW(iniFile.getResolved("cycle", "user"), runtime_error);
+    size_t cached = iniFile.stats().resolvedValues;
+    EXPECT_THROW(iniFile.getResolved("cycle", "a"), runtime_error);
+    EXPECT_THROW(iniFile.getResolved("cycle", "b"), runtime_error);
+    EXPECT_EQ(iniFile.stats().resolvedValues, cached);      // l'errore e' in cache, nessuna nuova visita
+
+    iniFile.set("cycle", "b", "fixed");
+    EXPECT_EQ(iniFile.getResolved("cycle", "user"), "fixed");
+}
+
+TEST_F(IniInterpolationTest, RepeatedCycleErrorsDoNotGrowTheGraph)
+{
+    iniFile.set("cycle", "a", "${b}");
+    iniFile.set("cycle", "b", "${a}");
+    iniFile.set("cycle", "user", "${a}${a}");
+    iniFile.set("cycle", "outer", "${user}");
+
+    EXPECT_THROW(iniFile.getResolved("cycle", "outer"), runtime_error);
+    IniFileStats first = iniFile.stats();
+    EXPECT_EQ(first.resolvedValues, 4);         // anche user e outer, che usano il ciclo, restano in errore
+    EXPECT_EQ(first.resolvedReferences, 4);     // user -> a una volta sola
+
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_THROW(iniFile.getResolved("cycle", "outer"), runtime_error);
+        EXPECT_THROW(iniFile.getResolved("cycle", "user"), runtime_error);
+    }
+    EXPECT_EQ(iniFile.stats().resolvedValues, first.resolvedValues);
+    EXPECT_EQ(iniFile.stats().resolvedReferences, first.resolvedReferences);
+
+    iniFile.set("cycle", "b", "fixed");
+    EXPECT_EQ(iniFile.getResolved("cycle", "outer"), "fixedfixed");
+    EXPECT_EQ(iniFile.stats().resolvedReferences, 3);
+}
+
+TEST_F(IniInterpolationTest, CopiesDoNotShareTheCache)
+{
+    EXPECT_EQ(iniFile.getResolved("paths", "logs"), "/opt/app/logs");
+
+    IniFile copy = iniFile;
+    copy.set("paths", "base", "/copy");
+    EXPECT_EQ(copy.getResolved("paths", "logs"), "/copy/logs");
+    EXPECT_EQ(iniFile.getResolved("paths", "logs"), "/opt/app/logs");
+
+    iniFile = copy;
+    EXPECT_EQ(iniFile.getResolved("paths", "logs"), "/copy/logs");
+}
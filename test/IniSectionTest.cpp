@@ -0,0 +1,101 @@
+#include <memory_resource>
+#include "gtest/gtest.h"
+#include "../IniFile.h"
+#include "../IniTransaction.h"
+#include "../VersionedIniFile.h"
+
+// Sezioni copy-on-write: una copia di IniFile condivide tutte le sezioni finche' non le modifica
+
+static IniFile makeSections(size_t sections, size_t keys)
+{
+    IniFile ini;
+    for (size_t s = 0; s < sections; s++)
+    {
+        for (size_t k = 0; k < keys; k++)
+            ini.set("section" + to_string(s), "key" + to_string(k), "value" + to_string(k));
+    }
+    return ini;
+}
+
+TEST(IniSectionTest, CopySharesEverySection)
+{
+    IniFile original = makeSections(10, 20);
+    IniFile copy = original;
+
+    EXPECT_EQ(copy.sharedSections(original), 10);
+    EXPECT_EQ(copy.print(true), original.print(true));
+    EXPECT_TRUE(IniFile::diff(original, copy).empty());
+}
+
+TEST(IniSectionTest, WriteClonesOnlyTheTouchedSection)
+{
+    IniFile original = makeSections(10, 20);
+    IniFile copy = original;
+
+    copy.set("section3", "key1", "changed");
+    EXPECT_TRUE(copy.deleteKey("section4", "key2"));
+    copy.set("section11", "key", "new");
+    copy.addSection("section5");        // nessuna modifica alle chiavi: resta condivisa
+
+    EXPECT_EQ(copy.sharedSections(original), 8);
+    EXPECT_EQ(original.get("section3", "key1"), "value1");
+    EXPECT_TRUE(original.hasKey("section4", "key2"));
+    EXPECT_FALSE(original.hasSection("section11"));
+    EXPECT_EQ(copy.get("section3", "key1"), "changed");
+    EXPECT_FALSE(copy.hasKey("section4", "key2"));
+
+    vector<IniChange> changes = IniFile::diff(original, copy);
+    ASSERT_EQ(changes.size(), 3);
+    EXPECT_EQ(changes[0].section, "section11");
+    EXPECT_EQ(changes[1].section, "section3");
+    EXPECT_EQ(changes[2].section, "section4");
+
+    // la sezione separata dalla copia resta modificabile anche nell'originale senza effetti sull'altra
+    original.set("section3", "key1", "original");
+    EXPECT_EQ(copy.get("section3", "key1"), "changed");
+}
+
+TEST(IniSectionTest, CommitAndCommentsRespectSharing)
+{
+    IniFile original = makeSections(4, 4);
+    original.setKeyComment("section0", "key0", "; comment\n");
+    IniFile copy = original;
+
+    IniTransaction transaction;
+    transaction.set("section1", "key0", "changed").deleteKey("section2", "key1").deleteSection("section3");
+    copy.commit(transaction);
+    copy.setKeyComment("section0", "key0", "; edited\n");
+
+    EXPECT_EQ(copy.sharedSections(original), 1);
+    EXPECT_EQ(original.get("section1", "key0"), "value0");
+    EXPECT_TRUE(original.hasKey("section2", "key1"));
+    EXPECT_TRUE(original.hasSection("section3"));
+    EXPECT_EQ(original.getKeyComment("section0", "key0"), "; comment\n");
+    EXPECT_EQ(copy.getKeyComment("section0", "key0"), "; edited\n");
+}
+
+TEST(IniSectionTest, CopyIntoAnotherResourceIsDeep)
+{
+    IniFile original = makeSections(3, 3);
+    pmr::monotonic_buffer_resource arena;
+    IniFile moved(original, &arena);
+
+    EXPECT_EQ(moved.sharedSections(original), 0);
+    EXPECT_EQ(moved.print(true), original.print(true));
+
+    IniFile sameResource(moved, &arena);
+    EXPECT_EQ(sameResource.sharedSections(moved), 3);
+}
+
+TEST(IniSectionTest, VersionedFileSharesWithItsSource)
+{
+    IniFile source = makeSections(3, 3);
+    VersionedIniFile versioned(source);
+    source.set("section0", "key0", "changed");
+
+    VersionedIniFile::View view = versioned.pin();
+    EXPECT_EQ(view.get("section0", "key0"), "value0");
+
+    IniFile snapshot = view.toIniFile();
+    EXPECT_EQ(snapshot.sharedSections(source), 2);
+}
@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include "gtest/gtest.h"
+#include "../IniSnapshot.h"
+
+class IniSnapshotTest : public ::testing::Test
+{
+    protected:
+        const string sourceFile = "snapshot_test.ini";
+        const string snapshotFile = "snapshot_test.ini.snap";
+
+        void SetUp() override
+        {
+            writeSource("; general comment\n[General]\nName=TestApp\n; version comment\nversion=1.0\n"
+                        "[network]\nhost=localhost\nport=8080\n[empty]\n");
+        }
+
+        void TearDown() override
+        {
+            remove(sourceFile.c_str());
+            remove(snapshotFile.c_str());
+        }
+
+        void writeSource(const string& content) const
+        {
+            ofstream file(sourceFile);
+            file << content;
+        }
+};
+
+TEST_F(IniSnapshotTest, LookupsMatchTheSource)
+{
+    IniFile ini(sourceFile);
+    IniSnapshot::write(ini, snapshotFile, FileFingerprint::of(sourceFile));
+    IniSnapshot snapshot = IniSnapshot::open(snapshotFile);
+
+    EXPECT_EQ(snapshot.sectionCount(), 2);      // le sezioni senza chiavi non vengono caricate dal testo
+    EXPECT_EQ(snapshot.keyCount(), 4);
+    EXPECT_EQ(snapshot.get("GENERAL", "name"), "TestApp");
+    EXPECT_EQ(snapshot.getView("network", "Port"), "8080");
+    EXPECT_EQ(snapshot.get("network", "missing"), "");
+    EXPECT_FALSE(snapshot.hasSection("missing"));
+    EXPECT_TRUE(snapshot.hasKey("general", "version"));
+    EXPECT_EQ(snapshot.getSectionComment("general"), "; general comment\n");
+    EXPECT_EQ(snapshot.getKeyComment("general", "version"), "; version comment\n");
+    EXPECT_EQ(snapshot.toIniFile().print(true), ini.print(true));
+}
+
+TEST_F(IniSnapshotTest, OpenForPrefersAFreshSnapshot)
+{
+    IniSnapshot first = IniSnapshot::openFor(sourceFile);
+    EXPECT_TRUE(first.fromText());
+    EXPECT_TRUE(IniSnapshot::isFresh(snapshotFile, sourceFile));
+
+    IniSnapshot second = IniSnapshot::openFor(sourceFile);
+    EXPECT_FALSE(second.fromText());
+    EXPECT_EQ(second.get("network", "host"), "localhost");
+
+    // stesso contenuto ma mtime diverso: l'hash conferma che lo snapshot e' ancora valido
+    this_thread::sleep_for(chrono::milliseconds(10));
+    writeSource("; general comment\n[General]\nName=TestApp\n; version comment\nversion=1.0\n"
+                "[network]\nhost=localhost\nport=8080\n[empty]\n");
+    EXPECT_TRUE(IniSnapshot::isFresh(snapshotFile, sourceFile));
+
+    writeSource("[network]\nhost=example.org\n");
+    EXPECT_FALSE(IniSnapshot::isFresh(snapshotFile, sourceFile));
+    IniSnapshot third = IniSnapshot::openFor(sourceFile);
+    EXPECT_TRUE(third.fromText());
+    EXPECT_EQ(third.get("network", "host"), "example.org");
+    EXPECT_FALSE(third.hasSection("general"));
+}
+
+TEST_F(IniSnapshotTest, CorruptedSnapshotsAreRejected)
+{
+    IniSnapshot::write(IniFile(sourceFile), snapshotFile, FileFingerprint::of(sourceFile));
+    {
+        fstream file(snapshotFile, ios::in | ios::out | ios::binary);
+        file.seekp(-3, ios::end);
+        file.put('X');
+    }
+
+    EXPECT_THROW(IniSnapshot::open(snapshotFile), runtime_error);
+    EXPECT_THROW(IniSnapshot::open("missing.snap"), runtime_error);
+
+    // openFor ricostruisce lo snapshot dal testo
+    IniSnapshot rebuilt = IniSnapshot::openFor(sourceFile);
+    EXPECT_TRUE(rebuilt.fromText());
+    EXPECT_EQ(rebuilt.get("general", "name"), "TestApp");
+}
@@ -0,0 +1,124 @@
+#include <cstdio>
+#include <thread>
+#include "gtest/gtest.h"
+#include "../IniFile.h"
+#include "../IniTransaction.h"
+
+TEST(IniStatsTest, ContentIsAlwaysReported)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+    iniFile.set("other", "a", "1");
+    iniFile.setSectionComment("other", "; c\n");
+
+    IniFileStats stats = iniFile.stats();
+    EXPECT_EQ(stats.sections, 2);
+    EXPECT_EQ(stats.keys, 2);
+    EXPECT_EQ(stats.bytes, string("sectionkeyvalueothera1; c\n").size());
+}
+
+#if INIMANAGER_STATS
+
+TEST(IniStatsTest, CountsLookupsAndMutations)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+    iniFile.set("section", "key", "changed");
+    iniFile.get("section", "key");
+    iniFile.get("section", "missing");
+    iniFile.get("missing", "key");
+    iniFile.deleteKey("section", "key");
+    iniFile.deleteKey("section", "key");
+
+    IniFileStats stats = iniFile.stats();
+    EXPECT_TRUE(stats.enabled);
+    EXPECT_EQ(stats.getHits, 1);
+    EXPECT_EQ(stats.getMisses, 2);
+    EXPECT_EQ(stats.sets, 2);
+    EXPECT_EQ(stats.deletes, 1);        // la seconda cancellazione non trova nulla
+    EXPECT_EQ(stats.allocations, 2);    // sezione e chiave, la seconda set sovrascrive
+
+    IniTransaction transaction;
+    transaction.set("section", "a", "1").set("section", "b", "2").deleteSection("other");
+    iniFile.commit(transaction);
+    EXPECT_EQ(iniFile.stats().sets, 4);
+    EXPECT_EQ(iniFile.stats().deletes, 2);
+
+    iniFile.resetStats();
+    EXPECT_EQ(iniFile.stats().sets, 0);
+    EXPECT_EQ(iniFile.stats().keys, 2);
+}
+
+TEST(IniStatsTest, TimesLoadAndSave)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+    iniFile.setKeyComment("section", "key", "; comment\n");
+    iniFile.save("stats_test.ini");
+
+    IniFileStats stats = iniFile.stats();
+    EXPECT_EQ(stats.saves, 1);
+    EXPECT_EQ(stats.bytesWritten, string("[section]\n; comment\nkey=value\n").size());
+    EXPECT_GT(stats.saveTime.count(), 0);
+    EXPECT_EQ(stats.saveTime, stats.lastSaveTime);
+
+    IniFile loaded;
+    loaded.load("stats_test.ini");
+    stats = loaded.stats();
+    EXPECT_EQ(stats.loads, 1);
+    EXPECT_EQ(stats.bytesParsed, iniFile.stats().bytesWritten);
+    EXPECT_EQ(stats.allocations, 3);    // sezione, chiave e commento
+    EXPECT_GT(stats.loadTime.count(), 0);
+
+    remove("stats_test.ini");
+}
+
+TEST(IniStatsTest, CopiesStartFromZero)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+    iniFile.get("section", "key");
+
+    IniFile copy = iniFile;
+    EXPECT_EQ(copy.stats().getHits, 0);
+    EXPECT_EQ(copy.stats().keys, 1);
+}
+
+TEST(IniStatsTest, ConcurrentReadersAreCounted)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+
+    vector<thread> readers;
+    for (int t = 0; t < 4; t++)
+    {
+        readers.emplace_back([&iniFile]
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                iniFile.get("section", "key");
+                iniFile.get("section", "missing");
+            }
+        });
+    }
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(iniFile.stats().getHits, 4000);
+    EXPECT_EQ(iniFile.stats().getMisses, 4000);
+}
+
+#else
+
+TEST(IniStatsTest, CountersAreCompiledOut)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+    iniFile.get("section", "key");
+
+    EXPECT_FALSE(iniFile.stats().enabled);
+    EXPECT_EQ(iniFile.stats().sets, 0);
+    EXPECT_EQ(iniFile.stats().getHits, 0);
+}
+
+#endif
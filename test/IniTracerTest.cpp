@@ -0,0 +1,119 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../IniFile.h"
+#include "../IniTracer.h"
+#include "../ChromeTraceWriter.h"
+
+class RecordingTracer : public IniTracer
+{
+    public:
+        vector<string> spans;
+
+        void beginSpan(const char* name) override
+        {
+            spans.push_back(string("+") + name);
+        }
+
+        void endSpan(const char* name) override
+        {
+            spans.push_back(string("-") + name);
+        }
+};
+
+// disinstalla il tracer anche se un'asserzione fallisce
+class IniTracerTest : public ::testing::Test
+{
+    protected:
+        void TearDown() override
+        {
+            IniTracer::uninstall();
+        }
+};
+
+TEST_F(IniTracerTest, LoadSaveAndPrintPhases)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+
+    RecordingTracer tracer;
+    IniTracer::install(&tracer);
+
+    iniFile.save("tracer_test.ini");
+    EXPECT_EQ(tracer.spans, (vector<string>{"+IniFile::save", "+save.open", "-save.open", "+save.write",
+                                            "-save.write", "+save.close", "-save.close", "-IniFile::save"}));
+
+    tracer.spans.clear();
+    IniFile loaded;
+    loaded.load("tracer_test.ini");
+    EXPECT_EQ(tracer.spans, (vector<string>{"+IniFile::load", "+load.read", "-load.read", "+load.parse",
+                                            "-load.parse", "+load.fold", "-load.fold", "+load.insert",
+                                            "-load.insert", "-IniFile::load"}));
+    EXPECT_EQ(loaded.get("section", "key"), "value");
+
+    tracer.spans.clear();
+    EXPECT_EQ(loaded.print(false), "[section]\nkey=value\n");
+    EXPECT_EQ(tracer.spans, (vector<string>{"+IniFile::print", "+print.measure", "-print.measure",
+                                            "+print.format", "-print.format", "-IniFile::print"}));
+
+    remove("tracer_test.ini");
+}
+
+TEST_F(IniTracerTest, FailedLoadClosesSpans)
+{
+    RecordingTracer tracer;
+    IniTracer::install(&tracer);
+
+    IniFile iniFile;
+    EXPECT_THROW(iniFile.load("missing_tracer_test.ini"), runtime_error);
+    EXPECT_EQ(tracer.spans, (vector<string>{"+IniFile::load", "+load.read", "-load.read", "-IniFile::load"}));
+}
+
+TEST_F(IniTracerTest, LookupsAreSampled)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+
+    RecordingTracer tracer;
+    IniTracer::install(&tracer);
+    for (int i = 0; i < 100; i++)
+        iniFile.get("section", "key");
+    EXPECT_TRUE(tracer.spans.empty());      // di default get e set non vengono tracciate
+
+    IniTracer::install(&tracer, 10);
+    for (int i = 0; i < 100; i++)
+    {
+        iniFile.get("section", "key");
+        iniFile.set("section", "key", "value");
+    }
+    EXPECT_EQ(tracer.spans.size(), 2 * 200 / 10);
+}
+
+TEST_F(IniTracerTest, ChromeTraceWriterWritesTraceEvents)
+{
+    IniFile iniFile;
+    iniFile.set("section", "key", "value");
+    {
+        ChromeTraceWriter writer("tracer_test.json");
+        IniTracer::install(&writer);
+        iniFile.save("tracer_test.ini");
+        iniFile.load("tracer_test.ini");
+        IniTracer::uninstall();
+        EXPECT_EQ(writer.eventCount(), 2 * (4 + 5));
+    }
+
+    ifstream file("tracer_test.json");
+    stringstream content;
+    content << file.rdbuf();
+    string json = content.str();
+
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0);
+    EXPECT_NE(json.find("{\"name\":\"load.parse\",\"cat\":\"inimanager\",\"ph\":\"B\",\"ts\":"), string::npos);
+    EXPECT_NE(json.find("\"ph\":\"E\""), string::npos);
+    EXPECT_EQ(count(json.begin(), json.end(), '{'), count(json.begin(), json.end(), '}'));
+    EXPECT_EQ(json.substr(json.size() - 2), "}\n");
+
+    remove("tracer_test.ini");
+    remove("tracer_test.json");
+}
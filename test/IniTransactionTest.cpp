@@ -0,0 +1,112 @@
+#include <thread>
+#include "gtest/gtest.h"
+#include "../IniTransaction.h"
+#include "../ConcurrentIniFile.h"
+
+TEST(IniTransactionTest, CommitAppliesSetsAndDeletes)
+{
+    IniFile iniFile;
+    iniFile.set("section", "kept", "1");
+    iniFile.set("section", "removed", "2");
+    iniFile.set("old", "key", "value");
+
+    IniTransaction transaction;
+    transaction.set("Section", "Added", "3")
+               .set("section", "kept", "changed")
+               .deleteKey("section", "removed")
+               .deleteKey("missing", "key")
+               .deleteSection("old")
+               .set("new", "key", "value");
+    EXPECT_EQ(transaction.size(), 6);
+
+    iniFile.commit(transaction);
+
+    EXPECT_EQ(iniFile.get("section", "added"), "3");
+    EXPECT_EQ(iniFile.get("section", "kept"), "changed");
+    EXPECT_FALSE(iniFile.hasKey("section", "removed"));
+    EXPECT_FALSE(iniFile.hasSection("old"));
+    EXPECT_FALSE(iniFile.hasSection("missing"));
+    EXPECT_EQ(iniFile.get("new", "key"), "value");
+}
+
+TEST(IniTransactionTest, LaterOperationsWin)
+{
+    IniFile iniFile;
+    iniFile.set("section", "a", "old");
+    iniFile.set("section", "b", "old");
+
+    IniTransaction transaction;
+    transaction.set("section", "a", "first")
+               .set("section", "a", "second")
+               .deleteSection("section")
+               .set("section", "c", "after delete")
+               .set("other", "key", "value")
+               .deleteKey("other", "key");
+
+    iniFile.commit(transaction);
+
+    EXPECT_FALSE(iniFile.hasKey("section", "a"));
+    EXPECT_FALSE(iniFile.hasKey("section", "b"));
+    EXPECT_EQ(iniFile.get("section", "c"), "after delete");
+    EXPECT_FALSE(iniFile.hasSection("other"));
+}
+
+TEST(IniTransactionTest, CommitReportsChanges)
+{
+    IniFile iniFile;
+    iniFile.set("section", "same", "1");
+    iniFile.set("section", "changed", "old");
+
+    IniTransaction transaction;
+    transaction.set("section", "same", "1").set("section", "changed", "new").set("section", "added", "x");
+
+    vector<IniChange> changes;
+    iniFile.commit(transaction, &changes);
+
+    ASSERT_EQ(changes.size(), 2);
+    EXPECT_EQ(changes[0].type, IniChange::Type::Added);
+    EXPECT_EQ(changes[0].key, "added");
+    EXPECT_EQ(changes[1].type, IniChange::Type::Modified);
+    EXPECT_EQ(changes[1].oldValue, "old");
+}
+
+TEST(IniTransactionTest, ConcurrentReadersSeeWholeCommits)
+{
+    ConcurrentIniFile iniFile;
+    const int keys = 50;
+
+    IniTransaction initial;
+    for (int k = 0; k < keys; k++)
+        initial.set("section" + to_string(k % 5), "key" + to_string(k), "0");
+    iniFile.commit(initial);
+
+    atomic<bool> done{false};
+    atomic<int> inconsistent{0};
+    thread reader([&]
+    {
+        while (!done)
+        {
+            // ogni commit scrive lo stesso valore in tutte le chiavi
+            IniFile snapshot = iniFile.snapshot();
+            string expected = snapshot.get("section0", "key0");
+            for (int k = 0; k < keys; k++)
+            {
+                if (snapshot.get("section" + to_string(k % 5), "key" + to_string(k)) != expected)
+                    inconsistent++;
+            }
+        }
+    });
+
+    for (int i = 1; i <= 200; i++)
+    {
+        IniTransaction transaction;
+        for (int k = 0; k < keys; k++)
+            transaction.set("section" + to_string(k % 5), "key" + to_string(k), to_string(i));
+        iniFile.commit(transaction);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(inconsistent, 0);
+    EXPECT_EQ(iniFile.get("section4", "key49"), "200");
+}
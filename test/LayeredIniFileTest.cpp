@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "../LayeredIniFile.h"
+
+static IniFile defaultsLayer()
+{
+    IniFile ini;
+    ini.set("network", "host", "localhost");
+    ini.set("network", "port", "8080");
+    ini.set("logging", "level", "info");
+    ini.addSection("empty");
+    return ini;
+}
+
+static IniFile hostLayer()
+{
+    IniFile ini;
+    ini.set("Network", "Port", "9090");
+    ini.set("host", "name", "server01");
+    return ini;
+}
+
+TEST(LayeredIniFileTest, HigherLayersWin)
+{
+    LayeredIniFile layered;
+    layered.addLayer("defaults", defaultsLayer());
+    layered.addLayer("host", hostLayer());
+
+    EXPECT_EQ(layered.layerCount(), 2);
+    EXPECT_EQ(layered.get("network", "port"), "9090");
+    EXPECT_EQ(layered.layerOf("NETWORK", "port"), "host");
+    EXPECT_EQ(layered.get("network", "host"), "localhost");
+    EXPECT_EQ(layered.layerOf("network", "host"), "defaults");
+    EXPECT_EQ(layered.getView("host", "name"), "server01");
+    EXPECT_EQ(layered.get("network", "missing"), "");
+    EXPECT_TRUE(layered.hasSection("empty"));
+    EXPECT_FALSE(layered.hasKey("logging", "missing"));
+    EXPECT_THROW(layered.addLayer("host", IniFile()), invalid_argument);
+    EXPECT_THROW(layered.layer("runtime"), out_of_range);
+}
+
+TEST(LayeredIniFileTest, MutationsUpdateTheIndex)
+{
+    LayeredIniFile layered;
+    layered.addLayer("defaults", defaultsLayer());
+    layered.addLayer("host", hostLayer());
+    layered.addLayer("runtime", IniFile());
+
+    layered.set("runtime", "logging", "level", "debug");
+    EXPECT_EQ(layered.get("logging", "level"), "debug");
+
+    layered.set("defaults", "logging", "level", "warning");    // nascosto dal livello runtime
+    EXPECT_EQ(layered.get("logging", "level"), "debug");
+
+    EXPECT_TRUE(layered.deleteKey("runtime", "logging", "level"));
+    EXPECT_EQ(layered.get("logging", "level"), "warning");
+    EXPECT_FALSE(layered.deleteKey("runtime", "logging", "level"));
+
+    EXPECT_TRUE(layered.deleteSection("host", "network"));
+    EXPECT_EQ(layered.get("network", "port"), "8080");
+    EXPECT_TRUE(layered.hasSection("network"));
+
+    EXPECT_TRUE(layered.deleteSection("defaults", "network"));
+    EXPECT_FALSE(layered.hasSection("network"));
+    EXPECT_FALSE(layered.hasKey("network", "host"));
+}
+
+TEST(LayeredIniFileTest, ReplaceLayerAppliesOnlyDifferences)
+{
+    LayeredIniFile layered;
+    layered.addLayer("defaults", defaultsLayer());
+    layered.addLayer("host", hostLayer());
+
+    IniFile reloaded;
+    reloaded.set("host", "name", "server01");
+    reloaded.set("host", "zone", "eu");
+    reloaded.set("logging", "level", "error");
+    reloaded.setSectionComment("host", "; reloaded\n");
+
+    string_view unchanged = layered.getView("host", "name");
+    layered.replaceLayer("host", reloaded);
+
+    EXPECT_EQ(layered.get("network", "port"), "8080");     // rimossa dal livello host
+    EXPECT_EQ(layered.get("logging", "level"), "error");
+    EXPECT_EQ(layered.get("host", "zone"), "eu");
+    EXPECT_EQ(layered.getView("host", "name").data(), unchanged.data());   // stesso nodo, non ricopiato
+    EXPECT_EQ(layered.layer("host").getSectionComment("host"), "; reloaded\n");
+    EXPECT_FALSE(layered.layer("host").hasSection("network"));
+}
+
+TEST(LayeredIniFileTest, FlattenMatchesLookups)
+{
+    LayeredIniFile layered;
+    layered.addLayer("defaults", defaultsLayer());
+    layered.addLayer("host", hostLayer());
+
+    IniFile merged = layered.flatten();
+    EXPECT_EQ(merged.get("network", "port"), "9090");
+    EXPECT_EQ(merged.get("network", "host"), "localhost");
+    EXPECT_EQ(merged.get("host", "name"), "server01");
+    EXPECT_TRUE(merged.hasSection("empty"));
+}
+
+TEST(LayeredIniFileTest, WritesToSharedSectionsKeepTheIndexValid)
+{
+    LayeredIniFile layered;
+    {
+        IniFile local = defaultsLayer();
+        layered.addLayer("defaults", local);            // il livello condivide le sezioni con local
+        layered.set("defaults", "network", "port", "8081");
+    }
+    EXPECT_EQ(layered.get("network", "host"), "localhost");
+    EXPECT_EQ(layered.get("network", "port"), "8081");
+
+    {
+        IniFile merged = layered.flatten();              // condivide le sezioni presenti in un solo livello
+        EXPECT_TRUE(layered.deleteKey("defaults", "network", "port"));
+    }
+    EXPECT_EQ(layered.get("network", "host"), "localhost");
+    EXPECT_FALSE(layered.hasKey("network", "port"));
+
+    {
+        IniFile copy = layered.layer("defaults");
+        IniFile replacement = copy;
+        replacement.set("logging", "level", "debug");
+        replacement.set("logging", "file", "app.log");
+        layered.replaceLayer("defaults", replacement);
+        replacement.set("network", "host", "changed");
+    }
+    EXPECT_EQ(layered.get("network", "host"), "localhost");
+    EXPECT_EQ(layered.get("logging", "level"), "debug");
+    EXPECT_EQ(layered.get("logging", "file"), "app.log");
+}
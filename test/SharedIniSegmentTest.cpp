@@ -0,0 +1,133 @@
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "../SharedIniSegment.h"
+
+static string segmentName(const string& test)
+{
+    return "/inimanager_" + test + "_" + to_string(getpid());
+}
+
+TEST(SharedIniSegmentTest, PublishAndLookup)
+{
+    const string name = segmentName("lookup");
+    IniFile ini;
+    ini.set("General", "Name", "TestApp");
+    ini.set("Network", "Host", "localhost");
+    ini.set("Network", "Port", "8080");
+    ini.addSection("Empty");
+
+    SharedIniSegment writer = SharedIniSegment::create(name, 4096);
+    writer.publish(ini);
+
+    SharedIniSegment reader = SharedIniSegment::attach(name);
+    EXPECT_EQ(reader.generation(), 1);
+    EXPECT_EQ(reader.get("general", "name"), "TestApp");
+    EXPECT_EQ(reader.get("NETWORK", "Port"), "8080");
+    EXPECT_TRUE(reader.get("network", "missing").empty());
+    EXPECT_TRUE(reader.hasSection("empty"));
+    EXPECT_FALSE(reader.hasSection("missing"));
+    EXPECT_TRUE(reader.hasKey("network", "host"));
+    EXPECT_FALSE(reader.hasKey("empty", "host"));
+
+    EXPECT_THROW(reader.publish(ini), runtime_error);
+    EXPECT_TRUE(SharedIniSegment::remove(name));
+}
+
+TEST(SharedIniSegmentTest, RepublishSwapsBuffers)
+{
+    const string name = segmentName("republish");
+    SharedIniSegment writer = SharedIniSegment::create(name, 4096);
+    SharedIniSegment reader = SharedIniSegment::attach(name);
+
+    for (int i = 0; i < 5; i++)
+    {
+        IniFile ini;
+        ini.set("section", "value", to_string(i));
+        writer.publish(ini);
+
+        EXPECT_EQ(reader.generation(), i + 1);
+        EXPECT_EQ(reader.get("section", "value"), to_string(i));
+    }
+
+    SharedIniSegment::remove(name);
+}
+
+TEST(SharedIniSegmentTest, ReadersNeverSeeTornValues)
+{
+    const string name = segmentName("torn");
+    SharedIniSegment writer = SharedIniSegment::create(name, 4096);
+    SharedIniSegment reader = SharedIniSegment::attach(name);
+
+    IniFile ini;
+    ini.set("section", "key", "a");
+    writer.publish(ini);
+
+    atomic<bool> done{false};
+    atomic<int> torn{0};
+    thread readerThread([&]
+    {
+        while (!done)
+        {
+            // ogni valore pubblicato e' composto da un solo carattere ripetuto
+            string value = reader.get("section", "key");
+            if (value.empty() || value.find_first_not_of(value[0]) != string::npos)
+                torn++;
+        }
+    });
+
+    for (int i = 0; i < 2000; i++)
+    {
+        ini.set("section", "key", string(i % 100 + 1, static_cast<char>('a' + i % 26)));
+        writer.publish(ini);
+    }
+    done = true;
+    readerThread.join();
+
+    EXPECT_EQ(torn, 0);
+    SharedIniSegment::remove(name);
+}
+
+TEST(SharedIniSegmentTest, PublishTooLargeThrows)
+{
+    const string name = segmentName("too_large");
+    SharedIniSegment writer = SharedIniSegment::create(name, 64);
+
+    IniFile ini;
+    ini.set("section", "key", string(100, 'x'));
+    EXPECT_GT(SharedIniSegment::requiredSize(ini), 64);
+    EXPECT_THROW(writer.publish(ini), runtime_error);
+
+    SharedIniSegment::remove(name);
+}
+
+TEST(SharedIniSegmentTest, ReadableFromAnotherProcess)
+{
+    const string name = segmentName("process");
+    IniFile ini;
+    ini.set("section", "key", "shared value");
+
+    SharedIniSegment writer = SharedIniSegment::create(name, 4096);
+    writer.publish(ini);
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        SharedIniSegment reader = SharedIniSegment::attach(name);
+        _exit(reader.get("section", "key") == "shared value" ? 0 : 1);
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    SharedIniSegment::remove(name);
+}
+
+TEST(SharedIniSegmentTest, AttachMissingSegmentThrows)
+{
+    EXPECT_THROW(SharedIniSegment::attach(segmentName("missing")), runtime_error);
+}
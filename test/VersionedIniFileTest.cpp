@@ -0,0 +1,178 @@
+#include <random>
+#include <thread>
+#include "gtest/gtest.h"
+#include "AllocationCounter.h"
+#include "../VersionedIniFile.h"
+
+static IniFile initialIniFile()
+{
+    IniFile ini;
+    ini.set("general", "name", "TestApp");
+    ini.set("network", "host", "localhost");
+    ini.set("network", "port", "8080");
+    ini.setSectionComment("network", "; network settings\n");
+    return ini;
+}
+
+TEST(VersionedIniFileTest, PinnedViewIsStable)
+{
+    VersionedIniFile versioned(initialIniFile());
+    VersionedIniFile::View before = versioned.pin();
+    EXPECT_EQ(before.version(), 1);
+
+    IniTransaction transaction;
+    transaction.set("network", "port", "9090").deleteKey("network", "host").set("new", "key", "value");
+    EXPECT_EQ(versioned.commit(transaction), 2);
+
+    EXPECT_EQ(before.get("network", "port"), "8080");
+    EXPECT_TRUE(before.hasKey("network", "host"));
+    EXPECT_FALSE(before.hasSection("new"));
+
+    VersionedIniFile::View after = versioned.pin();
+    EXPECT_EQ(after.version(), 2);
+    EXPECT_EQ(after.get("NETWORK", "Port"), "9090");
+    EXPECT_FALSE(after.hasKey("network", "host"));
+    EXPECT_EQ(after.get("new", "key"), "value");
+    EXPECT_EQ(after.getSectionComment("network"), "; network settings\n");
+}
+
+TEST(VersionedIniFileTest, UnchangedSectionsAreShared)
+{
+    VersionedIniFile versioned(initialIniFile());
+    VersionedIniFile::View before = versioned.pin();
+
+    IniTransaction transaction;
+    transaction.set("network", "port", "9090");
+    versioned.commit(transaction);
+
+    VersionedIniFile::View after = versioned.pin();
+    EXPECT_EQ(after.sharedSections(before), 1);     // solo "general" e' rimasta invariata
+    EXPECT_EQ(after.sharedSections(after), 2);
+}
+
+TEST(VersionedIniFileTest, UnpinnedVersionsAreCollected)
+{
+    VersionedIniFile versioned(initialIniFile());
+
+    IniTransaction transaction;
+    transaction.set("general", "name", "v2");
+    {
+        VersionedIniFile::View pinned = versioned.pin(1);
+        versioned.commit(transaction);
+
+        EXPECT_EQ(versioned.retainedVersions(), 2);
+        EXPECT_EQ(versioned.pin(1).get("general", "name"), "TestApp");
+    }
+
+    EXPECT_EQ(versioned.retainedVersions(), 1);
+    EXPECT_THROW(versioned.pin(1), out_of_range);
+    EXPECT_EQ(versioned.pin(2).get("general", "name"), "v2");
+}
+
+TEST(VersionedIniFileTest, ReadersKeepConsistentViewDuringCommits)
+{
+    VersionedIniFile versioned;
+
+    atomic<bool> done{false};
+    atomic<int> inconsistent{0};
+    thread reader([&]
+    {
+        while (!done)
+        {
+            // ogni versione ha lo stesso valore in "a" e "b", anche se stanno in sezioni diverse
+            VersionedIniFile::View view = versioned.pin();
+            if (view.get("a", "value") != view.get("b", "value"))
+                inconsistent++;
+        }
+    });
+
+    for (int i = 0; i < 500; i++)
+    {
+        IniTransaction transaction;
+        transaction.set("a", "value", to_string(i)).set("b", "value", to_string(i));
+        versioned.commit(transaction);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(inconsistent, 0);
+    EXPECT_EQ(versioned.currentVersion(), 501);
+    EXPECT_EQ(versioned.pin().toIniFile().get("b", "value"), "499");
+}
+
+TEST(VersionedIniFileTest, CommitCopiesOnlyThePathToTheTouchedSection)
+{
+    IniFile initial;
+    for (int s = 0; s < 4096; s++)
+        initial.set("s" + to_string(s), "key", "value");
+    VersionedIniFile versioned(initial);
+    VersionedIniFile::View before = versioned.pin();
+
+    IniTransaction transaction;
+    transaction.set("s1234", "key", "changed");
+    AllocationCounter counter;
+    versioned.commit(transaction);
+    uint64_t allocations = counter.allocations();
+
+    // con la tabella copiata per intero sarebbero almeno 4096 nodi
+    EXPECT_LT(allocations, 100);
+    EXPECT_EQ(versioned.pin().sharedSections(before), 4095);
+    EXPECT_EQ(before.get("s1234", "key"), "value");
+    EXPECT_EQ(versioned.pin().get("s1234", "key"), "changed");
+}
+
+TEST(VersionedIniFileTest, SectionTableMatchesIniFile)
+{
+    VersionedIniFile versioned;
+    IniFile expected;
+    mt19937 random(7);
+
+    for (int round = 0; round < 200; round++)
+    {
+        IniTransaction transaction;
+        for (int i = 0; i < 5; i++)
+        {
+            string section = "section" + to_string(random() % 64);
+            switch (random() % 4)
+            {
+                case 0:
+                    transaction.deleteSection(section);
+                    break;
+                case 1:
+                    transaction.deleteKey(section, "key" + to_string(random() % 4));
+                    break;
+                default:
+                    transaction.set(section, "key" + to_string(random() % 4), to_string(round));
+                    break;
+            }
+        }
+        versioned.commit(transaction);
+        expected.commit(transaction);
+        ASSERT_EQ(versioned.pin().toIniFile().print(false), expected.print(false)) << "round " << round;
+    }
+}
+
+TEST(VersionedIniFileTest, CommitErasesCommentsOfDeletedKeys)
+{
+    IniFile initial = initialIniFile();
+    initial.setKeyComment("network", "host", "; host\n");
+    initial.setKeyComment("network", "port", "; port\n");
+    initial.setKeyComment("general", "name", "; name\n");
+    VersionedIniFile versioned(initial);
+    VersionedIniFile::View before = versioned.pin();
+
+    IniTransaction transaction;
+    transaction.deleteKey("network", "host").deleteSection("general").set("general", "other", "value");
+    versioned.commit(transaction);
+
+    transaction.clear();
+    transaction.set("network", "host", "again").set("general", "name", "again");
+    versioned.commit(transaction);
+
+    VersionedIniFile::View view = versioned.pin();
+    EXPECT_EQ(view.getKeyComment("network", "host"), "");
+    EXPECT_EQ(view.getKeyComment("network", "port"), "; port\n");
+    EXPECT_EQ(view.getKeyComment("general", "name"), "");
+    EXPECT_EQ(view.getSectionComment("network"), "; network settings\n");
+    EXPECT_EQ(before.getKeyComment("network", "host"), "; host\n");
+}
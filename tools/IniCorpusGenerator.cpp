@@ -0,0 +1,113 @@
+#include <iostream>
+#include <stdexcept>
+#include "../IniCorpus.h"
+
+// Scrive un file INI sintetico e deterministico, per test di scala e benchmark.
+// Esempio: IniManager_corpus --size 1G --comments 0.1 --crlf big.ini
+
+static void usage(const char* program)
+{
+    cerr << "Usage: " << program << " [options] <output.ini>\n"
+         << "  --seed N            seed del generatore (default 1)\n"
+         << "  --sections N        numero di sezioni (default 10)\n"
+         << "  --keys N            chiavi per sezione (default 10)\n"
+         << "  --size N[K|M|G]     dimensione approssimativa, calcola il numero di sezioni\n"
+         << "  --min-value N       lunghezza minima dei valori (default 1)\n"
+         << "  --max-value N       lunghezza massima dei valori (default 32)\n"
+         << "  --comments R        frazione di sezioni e chiavi con commento (0..1)\n"
+         << "  --long-lines R      frazione di valori lunghi (0..1)\n"
+         << "  --long-line-size N  lunghezza dei valori lunghi (default 4096)\n"
+         << "  --crlf              terminatori di riga CRLF\n"
+         << "  --mixed-case        maiuscole e minuscole casuali nei nomi\n";
+}
+
+static uint64_t parseSize(const string& text)
+{
+    size_t end = 0;
+    uint64_t value = stoull(text, &end);
+    if (end < text.size())
+    {
+        switch (toupper(static_cast<unsigned char>(text[end])))
+        {
+            case 'K': return value << 10;
+            case 'M': return value << 20;
+            case 'G': return value << 30;
+            default: throw invalid_argument("invalid size: " + text);
+        }
+    }
+
+    return value;
+}
+
+int main(int argc, char* argv[])
+{
+    IniCorpusOptions options;
+    uint64_t targetSize = 0;
+    string output;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string arg = argv[i];
+            auto next = [&]() -> string
+            {
+                if (i + 1 >= argc)
+                    throw invalid_argument("missing value for " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--seed")
+                options.seed = stoull(next());
+            else if (arg == "--sections")
+                options.sections = stoull(next());
+            else if (arg == "--keys")
+                options.keysPerSection = stoull(next());
+            else if (arg == "--size")
+                targetSize = parseSize(next());
+            else if (arg == "--min-value")
+                options.minValueSize = stoull(next());
+            else if (arg == "--max-value")
+                options.maxValueSize = stoull(next());
+            else if (arg == "--comments")
+                options.commentRatio = stod(next());
+            else if (arg == "--long-lines")
+                options.longLineRatio = stod(next());
+            else if (arg == "--long-line-size")
+                options.longLineSize = stoull(next());
+            else if (arg == "--crlf")
+                options.crlf = true;
+            else if (arg == "--mixed-case")
+                options.caseVariation = true;
+            else if (arg == "--help" || arg == "-h")
+            {
+                usage(argv[0]);
+                return 0;
+            }
+            else if (arg[0] == '-' || !output.empty())
+                throw invalid_argument("unexpected argument: " + arg);
+            else
+                output = arg;
+        }
+
+        if (output.empty())
+        {
+            usage(argv[0]);
+            return 2;
+        }
+
+        if (targetSize > 0)
+            options = IniCorpus::forTargetSize(targetSize, options);
+
+        uint64_t written = IniCorpus(options).write(output);
+        cout << output << ": " << options.sections << " sections, "
+             << options.sections * options.keysPerSection << " keys, " << written << " bytes" << endl;
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
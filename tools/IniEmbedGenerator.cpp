@@ -0,0 +1,217 @@
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include "../IniFile.h"
+
+// Genera un header C++ con il contenuto di un file INI, letto tramite IniFile:
+//  - una tabella constexpr ordinata e get()/hasKey() constexpr, senza distinzione tra maiuscole e minuscole;
+//  - una struct per sezione con un membro static constexpr tipizzato per chiave (int64_t, double, bool o
+//    string_view), cosi' config::network::port e' una costante di compilazione.
+// Uso: IniManager_embed <file.ini> <output.h> <namespace>
+
+static const set<string> reservedNames = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch",
+    "char", "char16_t", "char32_t", "char8_t", "class", "compl", "concept", "const", "consteval", "constexpr",
+    "constinit", "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete",
+    "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for",
+    "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+    "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast",
+    "requires", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct",
+    "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename",
+    "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+    // nomi usati dal codice generato
+    "Entry", "entries", "entryCount", "detail", "get", "hasKey", "source", "std",
+};
+
+static string identifier(const string& name, set<string>& used)
+{
+    string result;
+    for (char c : name)
+        result += isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    if (result.empty() || isdigit(static_cast<unsigned char>(result[0])))
+        result.insert(0, 1, '_');
+    if (reservedNames.count(result) > 0 || result.find("__") != string::npos)
+        result += '_';
+
+    // "a-b" e "a.b" diventano entrambi a_b: i duplicati ricevono un suffisso numerico
+    string unique = result;
+    for (int i = 2; used.count(unique) > 0; i++)
+        unique = result + "_" + to_string(i);
+    used.insert(unique);
+    return unique;
+}
+
+static string literal(const string& text)
+{
+    string result = "\"";
+    for (char c : text)
+    {
+        auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\')
+            result.append(1, '\\').append(1, c);
+        else if (byte < 0x20 || byte >= 0x7f)
+        {
+            // ottale a tre cifre: a differenza di \x non assorbe i caratteri successivi
+            char escaped[5];
+            snprintf(escaped, sizeof(escaped), "\\%03o", byte);
+            result += escaped;
+        }
+        else
+            result += c;
+    }
+
+    return result + "\"";
+}
+
+// "0755" o "007" non sono numeri decimali: restano stringhe, come "0x1F"
+static bool hasLeadingZero(const string& value)
+{
+    size_t digits = value[0] == '-' ? 1 : 0;
+    return value.size() > digits + 1 && value[digits] == '0' && isdigit(static_cast<unsigned char>(value[digits + 1]));
+}
+
+static string typedMember(const string& name, const string& value)
+{
+    if (!value.empty() && !hasLeadingZero(value))
+    {
+        const char* begin = value.c_str();
+        char* end = nullptr;
+
+        errno = 0;
+        long long integer = strtoll(begin, &end, 10);
+        if (*end == '\0' && errno == 0 && !isspace(static_cast<unsigned char>(value[0])) && value[0] != '+')
+            return "static constexpr std::int64_t " + name + " = " + to_string(integer) + "LL;";
+
+        errno = 0;
+        double real = strtod(begin, &end);
+        if (*end == '\0' && errno == 0 && isfinite(real) && value.find_first_of(".eE") != string::npos
+            && value.find_first_of("xXnN") == string::npos && !isspace(static_cast<unsigned char>(value[0])))
+        {
+            char text[32];
+            snprintf(text, sizeof(text), "%.17g", real);
+            return "static constexpr double " + name + " = " + text + ";";
+        }
+    }
+
+    string lower = value;
+    transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "true" || lower == "false")
+        return "static constexpr bool " + name + " = " + lower + ";";
+
+    return "static constexpr std::string_view " + name + " = " + literal(value) + ";";
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 4)
+    {
+        cerr << "Usage: " << argv[0] << " <file.ini> <output.h> <namespace>" << endl;
+        return 2;
+    }
+
+    try
+    {
+        IniFile ini;
+        ini.load(argv[1]);
+
+        // IniFile non espone l'iterazione: il contenuto si ricava dal diff rispetto a un file vuoto,
+        // che e' gia' ordinato per sezione e chiave
+        vector<IniChange> entries = IniFile::diff(IniFile(), ini);
+
+        string out;
+        out += "// Generated by IniManager_embed from " + string(argv[1]) + ". Do not edit.\n";
+        out += "#pragma once\n\n#include <cstddef>\n#include <cstdint>\n#include <string_view>\n\n";
+        out += "namespace " + string(argv[3]) + "\n{\n";
+        out += "    inline constexpr std::string_view source = " + literal(argv[1]) + ";\n\n";
+        out += "    struct Entry\n    {\n        std::string_view section;\n        std::string_view key;\n"
+               "        std::string_view value;\n    };\n\n";
+
+        out += "    inline constexpr Entry entries[] = {\n";
+        for (const auto& entry : entries)
+            out += "        {" + literal(entry.section) + ", " + literal(entry.key) + ", " + literal(entry.newValue) + "},\n";
+        if (entries.empty())
+            out += "        {\"\", \"\", \"\"},\n";    // un array constexpr non puo' essere vuoto
+        out += "    };\n";
+        out += "    inline constexpr std::size_t entryCount = " + to_string(entries.size()) + ";\n\n";
+
+        out += R"(    namespace detail
+    {
+        // i nomi salvati sono gia' minuscoli, si piega solo quello cercato
+        constexpr int compare(std::string_view stored, std::string_view wanted)
+        {
+            for (std::size_t i = 0; i < stored.size() && i < wanted.size(); i++)
+            {
+                char c = wanted[i] >= 'A' && wanted[i] <= 'Z' ? static_cast<char>(wanted[i] - 'A' + 'a') : wanted[i];
+                if (stored[i] != c)
+                    return static_cast<unsigned char>(stored[i]) < static_cast<unsigned char>(c) ? -1 : 1;
+            }
+            return stored.size() == wanted.size() ? 0 : (stored.size() < wanted.size() ? -1 : 1);
+        }
+
+        constexpr const Entry* find(std::string_view section, std::string_view key)
+        {
+            std::size_t low = 0, high = entryCount;
+            while (low < high)
+            {
+                std::size_t middle = low + (high - low) / 2;
+                int cmp = compare(entries[middle].section, section);
+                if (cmp == 0)
+                    cmp = compare(entries[middle].key, key);
+                if (cmp == 0)
+                    return &entries[middle];
+                if (cmp < 0)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            return nullptr;
+        }
+    }
+
+    constexpr std::string_view get(std::string_view section, std::string_view key)
+    {
+        const Entry* entry = detail::find(section, key);
+        return entry != nullptr ? entry->value : std::string_view();
+    }
+
+    constexpr bool hasKey(std::string_view section, std::string_view key)
+    {
+        return detail::find(section, key) != nullptr;
+    }
+)";
+
+        set<string> sectionNames;
+        for (size_t i = 0; i < entries.size();)
+        {
+            const string& section = entries[i].section;
+            string structName = identifier(section, sectionNames);
+            out += "\n    struct " + structName + "\n    {\n";
+            set<string> keyNames = {structName};    // un membro con il nome della classe non compilerebbe
+            for (; i < entries.size() && entries[i].section == section; i++)
+                out += "        " + typedMember(identifier(entries[i].key, keyNames), entries[i].newValue) + "\n";
+            out += "    };\n";
+        }
+        out += "}\n";
+
+        // il file viene riscritto solo se cambia, per non ricompilare chi lo include
+        ifstream existing(argv[2], ios::binary);
+        string previous((istreambuf_iterator<char>(existing)), istreambuf_iterator<char>());
+        if (previous != out)
+        {
+            ofstream file(argv[2], ios::binary);
+            file << out;
+            if (!file)
+                throw runtime_error("Error writing to the file: " + string(argv[2]));
+        }
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <iostream>
+#include "../IniSnapshot.h"
+
+// Costruisce in anticipo gli snapshot binari dei file INI, da eseguire ad esempio dopo un deploy.
+// Uso: IniManager_snapshot <file.ini> [file.ini.snap]
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        cerr << "Usage: " << argv[0] << " <file.ini> [snapshot]" << endl;
+        return 2;
+    }
+
+    string source = argv[1];
+    string snapshotFile = argc == 3 ? argv[2] : IniSnapshot::defaultPath(source);
+
+    try
+    {
+        if (IniSnapshot::isFresh(snapshotFile, source))
+        {
+            cout << snapshotFile << ": up to date" << endl;
+            return 0;
+        }
+
+        FileFingerprint fingerprint = FileFingerprint::of(source);
+        IniFile ini;
+        ini.load(source);
+        IniSnapshot::write(ini, snapshotFile, fingerprint);
+
+        IniSnapshot snapshot = IniSnapshot::open(snapshotFile);
+        cout << snapshotFile << ": " << snapshot.sectionCount() << " sections, " << snapshot.keyCount() << " keys" << endl;
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}